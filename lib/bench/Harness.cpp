@@ -0,0 +1,57 @@
+#include "Harness.hpp"
+#include "Instrumentation.hpp"
+
+#include <cstdio>
+#include <iostream>
+
+namespace oh::bench {
+
+size_t getAllocationCount() noexcept {
+    return static_cast <size_t> (oh::fir::detail::getAllocationCount());
+}
+
+Harness::Harness(Options options) : m_options(std::move(options)) {
+    m_options.repetitions = std::max <size_t> (m_options.repetitions, 1);
+}
+
+void Harness::record(Measurement m) {
+    if (m_options.list) {
+        std::cout << m.name << "\n";
+    } else {
+        const double ns_per_sample = m.ns_per_call / std::max <size_t> (m.samples, 1);
+        const double gmacs = m.macs / m.ns_per_call;
+        char line[256];
+        std::snprintf(line, sizeof(line), "%-48s %12.1f ns/call %10.3f ns/sample %8.2f GMAC/s %8.2f allocs/call\n",
+                      m.name.c_str(), m.ns_per_call, ns_per_sample, gmacs, m.allocations_per_call);
+        std::cout << line << std::flush;
+    }
+
+    m_results.push_back(std::move(m));
+}
+
+const std::vector <Measurement>& Harness::getResults() const noexcept {
+    return m_results;
+}
+
+void Harness::writeJSON(std::ostream& out, const std::vector <std::pair <std::string, std::string>>& context) const {
+    out << "{\n";
+    for (const auto& [key, value] : context) {
+        out << "  \"" << key << "\": " << value << ",\n";
+    }
+
+    out << "  \"benchmarks\": [\n";
+    for (size_t i = 0; i < m_results.size(); ++i) {
+        const Measurement& m = m_results[i];
+        char line[512];
+        std::snprintf(line, sizeof(line),
+                      "    {\"name\": \"%s\", \"samples\": %zu, \"macs\": %.0f, \"calls\": %zu, \"ns_per_call\": %.3f, "
+                      "\"ns_per_sample\": %.6f, \"gmac_per_s\": %.4f, \"allocs_per_call\": %.3f}%s\n",
+                      m.name.c_str(), m.samples, m.macs, m.calls, m.ns_per_call, m.ns_per_call / std::max <size_t> (m.samples, 1),
+                      m.ns_per_call > 0.0 ? m.macs / m.ns_per_call : 0.0, m.allocations_per_call,
+                      (i + 1 < m_results.size()) ? "," : "");
+        out << line;
+    }
+    out << "  ]\n}\n";
+}
+
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <chrono>
+#include <algorithm>
+#include <ostream>
+#include <utility>
+
+///<    a small self-contained benchmark harness, the easydsp_bench target uses it to time every hot path of the library
+
+namespace oh::bench {
+
+/// @brief number of allocations made by operator new on all threads since the start of the program (counted by easydsp_count_allocations)
+/// @return count
+size_t getAllocationCount() noexcept;
+
+/// @brief keeps the compiler from removing a value that is never used
+template <class T>
+inline void doNotOptimize(const T& value) noexcept {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/// @brief settings of a run, set from the command line
+struct Options {
+    double min_time = 0.2;                  ///<    seconds spent measuring every benchmark
+    size_t repetitions = 5;                 ///<    timed batches, the median is reported
+    std::string filter;                     ///<    only benchmarks whose name contains it are run
+    bool list = false;                      ///<    print the names instead of running
+};
+
+/// @brief result of one benchmark
+struct Measurement {
+    std::string name;
+    size_t samples;                         ///<    samples processed by one call (taps for designs)
+    double macs;                            ///<    multiply-adds of one call in direct form, 0 if not meaningful
+    size_t calls;                           ///<    calls per timed batch
+    double ns_per_call;                     ///<    median over the batches
+    double allocations_per_call;
+};
+
+/// @brief times benchmarks and collects their results
+class Harness {
+
+    private:
+
+    Options m_options;
+
+    std::vector <Measurement> m_results;
+
+    /// @brief adds a result and prints it
+    void record(Measurement measurement);
+
+    public:
+
+    explicit Harness(Options options);
+
+    /// @brief runs a benchmark if its name passes the filter
+    /// every call of the body is one unit of work: the batch size is doubled until a batch takes
+    /// min_time/repetitions, then repetitions batches are timed
+    /// @param name unique name, groups are separated with '/'
+    /// @param samples samples processed by one call
+    /// @param macs multiply-adds of one call, 0 if not meaningful
+    /// @param body the work, called many times
+    template <class Body>
+    void run(const std::string& name, size_t samples, double macs, Body&& body) {
+        if (!m_options.filter.empty() && name.find(m_options.filter) == std::string::npos) {
+            return;
+        }
+
+        if (m_options.list) {
+            record({name, samples, macs, 0, 0.0, 0.0});
+            return;
+        }
+
+        using clock = std::chrono::steady_clock;
+        const double batch_time = m_options.min_time / m_options.repetitions;
+
+        ///<    the first call warms up caches and the library's scratch buffers
+        body();
+
+        size_t calls = 1;
+        for (;;) {
+            const auto start = clock::now();
+            for (size_t i = 0; i < calls; ++i) {
+                body();
+            }
+            const double elapsed = std::chrono::duration <double> (clock::now() - start).count();
+            if (elapsed >= batch_time || calls >= (size_t(1) << 30)) {
+                break;
+            }
+            calls *= 2;
+        }
+
+        std::vector <double> times;
+        times.reserve(m_options.repetitions);
+        const size_t allocations = getAllocationCount();
+        for (size_t r = 0; r < m_options.repetitions; ++r) {
+            const auto start = clock::now();
+            for (size_t i = 0; i < calls; ++i) {
+                body();
+            }
+            times.push_back(std::chrono::duration <double, std::nano> (clock::now() - start).count() / calls);
+        }
+        const double allocations_per_call = static_cast <double> (getAllocationCount() - allocations) / (calls * m_options.repetitions);
+
+        std::sort(times.begin(), times.end());
+        record({name, samples, macs, calls, times[times.size() / 2], allocations_per_call});
+    }
+
+    const std::vector <Measurement>& getResults() const noexcept;
+
+    /// @brief writes all results as json
+    /// @param out stream to write to
+    /// @param context extra fields of the top level object, pairs of name and (already quoted) value
+    void writeJSON(std::ostream& out, const std::vector <std::pair <std::string, std::string>>& context) const;
+
+};
+
+}
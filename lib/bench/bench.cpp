@@ -0,0 +1,369 @@
+#include "EasyDSP.hpp"
+#include "Harness.hpp"
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <cstdint>
+#include <cstdlib>
+#include <span>
+#include <memory>
+
+///<    easydsp_bench: times the hot paths of the library, run with --help for the options
+///<    ns/sample is the time of one call divided by the input samples (or taps for designs),
+///<    GMAC/s counts the multiply-adds of the direct form, so fft paths show their speed-up as a higher rate
+
+namespace {
+
+using namespace oh::fir;
+using oh::bench::Harness;
+using oh::bench::doNotOptimize;
+using oh::wnd::WindowType;
+
+/// @brief sizes used by the suite, --quick drops the largest ones
+struct Sizes {
+    std::vector <size_t> signals;
+    std::vector <size_t> taps;
+    std::vector <size_t> windows;
+    std::vector <size_t> designs;
+};
+
+std::vector <double> makeSignal(size_t size) {
+    std::mt19937 generator(42);
+    std::normal_distribution <double> distribution;
+    std::vector <double> signal(size);
+    for (auto& v : signal) {
+        v = distribution(generator);
+    }
+    return signal;
+}
+
+FIR& getLowpass(size_t taps) {
+    ///<    designs are kept alive for the whole run, FIR is not copyable through the base class
+    static std::vector <std::unique_ptr <WindowLowpass>> designs;
+    for (auto& d : designs) {
+        if (d -> getSize() == taps) {
+            return *d;
+        }
+    }
+    designs.push_back(std::make_unique <WindowLowpass> (*WindowLowpass::create(0.1, taps, WindowType::Hamming)));
+    return *designs.back();
+}
+
+std::string label(const std::string& group, size_t signal, size_t taps) {
+    return group + "/" + std::to_string(signal) + "x" + std::to_string(taps);
+}
+
+void benchConvolve(Harness& harness, const Sizes& sizes) {
+    for (size_t N : sizes.signals) {
+        const std::vector <double> signal = makeSignal(N);
+        const std::vector <float> signal_float(signal.begin(), signal.end());
+
+        for (size_t M : sizes.taps) {
+            const FIR& fir = getLowpass(M);
+            const double macs = static_cast <double> (N) * M;
+
+            harness.run(label("convolve/vector", N, M), N, macs, [&] {
+                auto r = fir.convolve(signal);
+                doNotOptimize(r -> data());
+            });
+
+            std::vector <double> output(N + M - 1);
+            harness.run(label("convolve/automatic", N, M), N, macs, [&] {
+                auto r = fir.convolve(std::span <const double> (signal), std::span <double> (output), ConvolutionMethod::Automatic);
+                doNotOptimize(r);
+            });
+
+            std::vector <float> output_float(N + M - 1);
+            harness.run(label("convolve/span_float", N, M), N, macs, [&] {
+                auto r = fir.convolve(std::span <const float> (signal_float), std::span <float> (output_float));
+                doNotOptimize(r);
+            });
+
+            harness.run(label("convolve/direct", N, M), N, macs, [&] {
+                auto r = fir.convolve(std::span <const double> (signal), std::span <double> (output), ConvolutionMethod::Direct);
+                doNotOptimize(r);
+            });
+
+            harness.run(label("convolve/fft", N, M), N, macs, [&] {
+                auto r = fir.convolve(std::span <const double> (signal), std::span <double> (output), ConvolutionMethod::FFT);
+                doNotOptimize(r);
+            });
+
+            ///<    the signal is replaced by the result, so every call starts from a fresh copy
+            std::vector <double> work;
+            harness.run(label("convolveInPlace", N, M), N, macs, [&] {
+                work.assign(signal.begin(), signal.end());
+                auto r = fir.convolveInPlace(work, ConvolutionMethod::Automatic);
+                doNotOptimize(r);
+            });
+
+            harness.run(label("convolveParallel", N, M), N, macs, [&] {
+                auto r = fir.convolveParallel(std::span <const double> (signal), std::span <double> (output));
+                doNotOptimize(r);
+            });
+        }
+    }
+}
+
+void benchWindow(Harness& harness, const Sizes& sizes) {
+    for (size_t N : sizes.windows) {
+        const size_t size = N | 1;
+        const auto window = oh::wnd::Window::create(WindowType::Blackman, size);
+        const std::vector <double> signal = makeSignal(size);
+        std::vector <double> work = signal;
+        std::vector <float> work_float(signal.begin(), signal.end());
+
+        harness.run("window/apply/" + std::to_string(size), size, size, [&] {
+            auto r = window -> apply(signal);
+            doNotOptimize(r -> data());
+        });
+
+        ///<    applying the window over and over would run into denormals, every call starts from a fresh copy
+        harness.run("window/applyInPlace/" + std::to_string(size), size, size, [&] {
+            work.assign(signal.begin(), signal.end());
+            auto r = window -> applyInPlace(work);
+            doNotOptimize(r);
+        });
+
+        harness.run("window/applyInPlace_float/" + std::to_string(size), size, size, [&] {
+            work_float.assign(signal.begin(), signal.end());
+            auto r = window -> applyInPlace(work_float);
+            doNotOptimize(r);
+        });
+
+        harness.run("window/create/" + std::to_string(size), size, 0, [&] {
+            auto r = oh::wnd::Window::create(WindowType::Blackman, size);
+            doNotOptimize(r);
+        });
+    }
+}
+
+void benchDesign(Harness& harness, const Sizes& sizes) {
+    for (size_t M : sizes.designs) {
+        const std::string taps = std::to_string(M);
+
+        harness.run("design/WindowLowpass/" + taps, M, 0, [&] {
+            auto r = WindowLowpass::create(0.1, M, WindowType::Hamming);
+            doNotOptimize(r);
+        });
+
+        harness.run("design/WindowHighpass/" + taps, M, 0, [&] {
+            auto r = WindowHighpass::create(0.2, M, WindowType::Hamming);
+            doNotOptimize(r);
+        });
+
+        harness.run("design/WindowBandpass/" + taps, M, 0, [&] {
+            auto r = WindowBandpass::create(0.1, 0.2, M, WindowType::Hamming);
+            doNotOptimize(r);
+        });
+
+        std::vector <double> spectrum(M / 2, 0.0);
+        for (size_t k = 0; k < spectrum.size() / 4; ++k) {
+            spectrum[k] = 1.0;
+        }
+        harness.run("design/FrequencySampling/" + taps, M, 0, [&] {
+            auto r = FrequencySampling::create(spectrum);
+            doNotOptimize(r);
+        });
+    }
+}
+
+void benchStreaming(Harness& harness, const Sizes& sizes) {
+    const size_t N = sizes.signals.front() * 64;
+    const std::vector <double> signal = makeSignal(N);
+    std::vector <double> output(N);
+
+    for (size_t M : sizes.taps) {
+        for (size_t block : {64, 4096}) {
+            auto stream = StreamingFIR::create(getLowpass(M));
+            harness.run("streaming/" + std::to_string(M) + "/block" + std::to_string(block), N, static_cast <double> (N) * M, [&] {
+                for (size_t offset = 0; offset + block <= N; offset += block) {
+                    stream -> process(std::span <const double> (signal.data() + offset, block), std::span <double> (output.data() + offset, block));
+                }
+                doNotOptimize(output.data());
+            });
+        }
+
+        auto partitioned = PartitionedConvolver::create(getLowpass(M), 256);
+        harness.run("partitioned/" + std::to_string(M) + "/block256", N, static_cast <double> (N) * M, [&] {
+            for (size_t offset = 0; offset + 256 <= N; offset += 256) {
+                partitioned -> process(std::span <const double> (signal.data() + offset, 256), std::span <double> (output.data() + offset, 256));
+            }
+            doNotOptimize(output.data());
+        });
+    }
+}
+
+void benchMultirate(Harness& harness, const Sizes& sizes) {
+    const size_t N = sizes.signals.back();
+    const std::vector <double> signal = makeSignal(N);
+    std::vector <double> output(N * 4 + 16);
+
+    const FIR& fir = getLowpass(127);
+
+    auto decimator = Decimator::create(fir, 4);
+    harness.run("multirate/decimator/4x127", N, static_cast <double> (N) * 127 / 4, [&] {
+        auto r = decimator -> process(std::span <const double> (signal), std::span <double> (output));
+        doNotOptimize(r);
+    });
+
+    auto interpolator = Interpolator::create(fir, 4);
+    harness.run("multirate/interpolator/4x127", N, static_cast <double> (N) * 127, [&] {
+        auto r = interpolator -> process(std::span <const double> (signal), std::span <double> (output));
+        doNotOptimize(r);
+    });
+
+    auto resampler = Resampler::create(160, 147, 0.1);
+    const double resampler_macs = static_cast <double> (N) * resampler -> getSize() / 147;
+    harness.run("multirate/resampler/160-147", N, resampler_macs, [&] {
+        auto r = resampler -> process(std::span <const double> (signal), std::span <double> (output));
+        doNotOptimize(r);
+    });
+}
+
+void benchOthers(Harness& harness, const Sizes& sizes) {
+    const size_t N = sizes.signals.back();
+    const std::vector <double> signal = makeSignal(N);
+    const FIR& fir = getLowpass(63);
+    const double macs = static_cast <double> (N) * 63;
+
+    std::vector <int16_t> q15(N);
+    std::vector <int32_t> q31(N);
+    for (size_t i = 0; i < N; ++i) {
+        q15[i] = static_cast <int16_t> (signal[i] * 4096);
+        q31[i] = static_cast <int32_t> (signal[i] * 268435456.0);
+    }
+    std::vector <int16_t> q15_output(N + 62);
+    std::vector <int32_t> q31_output(N + 62);
+
+    auto q15_fir = Q15FIR::create(fir);
+    harness.run(label("fixedpoint/q15", N, 63), N, macs, [&] {
+        auto r = q15_fir -> convolve(std::span <const int16_t> (q15), std::span <int16_t> (q15_output));
+        doNotOptimize(r);
+    });
+
+    auto q31_fir = Q31FIR::create(fir);
+    harness.run(label("fixedpoint/q31", N, 63), N, macs, [&] {
+        auto r = q31_fir -> convolve(std::span <const int32_t> (q31), std::span <int32_t> (q31_output));
+        doNotOptimize(r);
+    });
+
+    const size_t channels = 8;
+    const size_t frames = N / channels;
+    std::vector <double> frames_output(N);
+    auto multichannel = MultichannelFIR::create(fir, channels);
+    for (ChannelLayout layout : {ChannelLayout::Planar, ChannelLayout::Interleaved}) {
+        harness.run("multichannel/8ch/" + toString(layout), frames * channels, static_cast <double> (frames * channels) * 63, [&] {
+            auto r = multichannel -> process(std::span <const double> (signal.data(), frames * channels), std::span <double> (frames_output), layout);
+            doNotOptimize(r);
+        });
+    }
+
+    std::vector <const FIR*> filters;
+    for (size_t M : {31, 63, 127, 255}) {
+        for (size_t i = 0; i < 4; ++i) {
+            filters.push_back(&getLowpass(M));
+        }
+    }
+    auto bank = FilterBank::create(filters);
+    std::vector <double> bank_output(filters.size() * (N + bank -> getMaxSize() - 1));
+    harness.run("filterbank/16filters", N, static_cast <double> (N) * 4 * (31 + 63 + 127 + 255), [&] {
+        auto r = bank -> convolve(std::span <const double> (signal), std::span <double> (bank_output));
+        doNotOptimize(r);
+    });
+}
+
+void printHelp() {
+    std::cout << "usage: easydsp_bench [options]\n"
+              << "  --json FILE        write the results as json to FILE\n"
+              << "  --filter TEXT      run only benchmarks whose name contains TEXT\n"
+              << "  --min-time SECONDS time spent measuring every benchmark (default 0.2)\n"
+              << "  --repetitions N    timed batches per benchmark, the median is reported (default 5)\n"
+              << "  --simd LEVEL       Scalar, SSE2, AVX2 or AVX512 (default: best supported)\n"
+              << "  --quick            smaller signals, for a fast check\n"
+              << "  --list             print the benchmark names and exit\n";
+}
+
+}
+
+int main(int argc, char** argv) {
+    oh::bench::Options options;
+    std::string json_path;
+    bool quick = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+
+        if (arg == "--json" && has_value) {
+            json_path = argv[++i];
+        } else if (arg == "--filter" && has_value) {
+            options.filter = argv[++i];
+        } else if (arg == "--min-time" && has_value) {
+            options.min_time = std::atof(argv[++i]);
+        } else if (arg == "--repetitions" && has_value) {
+            options.repetitions = static_cast <size_t> (std::atol(argv[++i]));
+        } else if (arg == "--simd" && has_value) {
+            const std::string level = argv[++i];
+            bool found = false;
+            for (SIMDLevel l : {SIMDLevel::Scalar, SIMDLevel::SSE2, SIMDLevel::AVX2, SIMDLevel::AVX512}) {
+                if (toString(l) == level) {
+                    found = static_cast <bool> (setSIMDLevel(l));
+                }
+            }
+            if (!found) {
+                std::cerr << "unsupported simd level: " << level << "\n";
+                return 1;
+            }
+        } else if (arg == "--quick") {
+            quick = true;
+        } else if (arg == "--list") {
+            options.list = true;
+        } else if (arg == "--help" || arg == "-h") {
+            printHelp();
+            return 0;
+        } else {
+            std::cerr << "unknown option: " << arg << "\n";
+            printHelp();
+            return 1;
+        }
+    }
+
+    Sizes sizes;
+    if (quick) {
+        sizes = {{1024, 65536}, {15, 255}, {1024, 65536}, {31, 1023}};
+    } else {
+        sizes = {{1024, 65536, 1048576}, {15, 63, 255, 1023}, {1024, 65536, 1048576}, {31, 255, 4095}};
+    }
+
+    if (!options.list) {
+        std::cout << "easydsp_bench, simd: " << toString(getSIMDLevel()) << "\n";
+    }
+
+    Harness harness(options);
+    benchConvolve(harness, sizes);
+    benchWindow(harness, sizes);
+    benchDesign(harness, sizes);
+    benchStreaming(harness, sizes);
+    benchMultirate(harness, sizes);
+    benchOthers(harness, sizes);
+
+    if (!json_path.empty() && !options.list) {
+        std::ofstream out(json_path);
+        if (!out) {
+            std::cerr << "cannot write " << json_path << "\n";
+            return 1;
+        }
+        harness.writeJSON(out, {
+            {"simd", "\"" + toString(getSIMDLevel()) + "\""},
+            {"quick", quick ? "true" : "false"},
+            {"min_time", std::to_string(options.min_time)},
+            {"repetitions", std::to_string(options.repetitions)}
+        });
+    }
+
+    return 0;
+}
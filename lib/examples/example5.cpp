@@ -0,0 +1,75 @@
+#include "EasyDSP.hpp"
+
+#include <vector>
+#include <iostream>
+#include <string>
+#include <expected>
+#include <cmath>
+#include <algorithm>
+
+int main() {
+    ///< example:
+
+    std::cout << "this example shows: " << std::endl;
+    std::cout << "-how to create a StreamingFIR from any FIR filter" << std::endl;
+    std::cout << "-how to filter a signal block by block" << std::endl;
+    std::cout << "-that the streamed result matches convolve()" << std::endl;
+    std::cout << std::endl;
+
+    size_t size_of_signal = 1000;
+    std::vector <double> signal(size_of_signal, 0.0);
+    for (size_t i = 0; i < size_of_signal; ++i) {
+        signal[i] = std::sin(i / 20.0) + 0.3 * std::sin(i * 1.3);
+    }
+
+    auto lp = oh::fir::WindowLowpass::create(0.1, 31, oh::wnd::WindowType::Hamming);
+    if(!lp) {
+        std::cout << toString(lp.error());
+        return -1;
+    }
+
+    auto stream = oh::fir::StreamingFIR::create(*lp);
+    if(!stream) {
+        std::cout << toString(stream.error());
+        return -1;
+    }
+
+    ///     blocks of uneven sizes, like the ones coming from an acquisition card
+
+    std::vector <size_t> block_sizes = {1, 7, 64, 100, 3, 256};
+    std::vector <double> streamed;
+    std::vector <double> block;
+    std::vector <double> filtered;
+
+    size_t position = 0;
+    size_t b = 0;
+    while (position < size_of_signal) {
+        size_t count = std::min(block_sizes[b % block_sizes.size()], size_of_signal - position);
+        block.assign(signal.begin() + position, signal.begin() + position + count);
+        filtered.resize(count);
+
+        if(auto w = stream -> process(block, filtered); !w) {
+            std::cout << toString(w.error());
+            return -1;
+        }
+
+        streamed.insert(streamed.end(), filtered.begin(), filtered.end());
+        position += count;
+        ++b;
+    }
+
+    auto reference = lp -> convolve(signal);
+    if(!reference) {
+        std::cout << toString(reference.error());
+        return -1;
+    }
+
+    double max_difference = 0.0;
+    for (size_t i = 0; i < size_of_signal; ++i) {
+        max_difference = std::max(max_difference, std::abs(streamed[i] - (*reference)[i]));
+    }
+
+    std::cout << "processed " << size_of_signal << " samples in " << b << " blocks" << std::endl;
+    std::cout << "max difference from convolve(): " << max_difference << std::endl;
+
+}
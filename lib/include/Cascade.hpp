@@ -0,0 +1,128 @@
+#pragma once
+
+#include "FIR.hpp"
+#include "StreamingFIR.hpp"
+#include "CoefficientFile.hpp"
+
+#include <vector>
+#include <cstddef>
+#include <expected>
+#include <span>
+#include <string>
+
+namespace oh::fir {
+
+/// @brief enum used to choose how a cascade of filters is run
+enum class CascadeMethod {
+    Automatic,
+    Merged,         ///<    one filter with the convolution of the taps of all stages
+    Staged          ///<    every stage in turn on one cache sized block of samples
+};
+
+/// @brief used to translate CascadeMethod to std::string
+/// @param method
+/// @return string
+std::string toString(oh::fir::CascadeMethod method);
+
+/// @brief merges filters applied one after another into one equivalent filter, its taps are the convolution of the taps of all stages
+/// @param stages filters in the order they are applied, none may be nullptr
+/// @return StoredFIR with getSize() = sum of the sizes - (number of stages - 1) on success, FIRError on failure,
+/// a single stage keeps its type, window and design parameters, merged stages are FIRType::Fixed
+std::expected <StoredFIR, FIRError> mergeStages(const std::vector <const FIR*>& stages);
+
+/// @brief a stateful processor running filters one after another, e.g. a highpass followed by a lowpass
+/// either the taps are merged into one filter (mergeStages()) or the stages run in place on blocks of CASCADE_BLOCK_SIZE samples,
+/// which stay in the cache while every stage passes over them, no full length intermediate signal is made in either case
+/// Automatic picks the cheaper one by the cost model of the convolutions (multiply-adds per output, folded kernels and fft included):
+/// merging saves a few taps in total, but loses the folded kernels when a symmetric stage meets an asymmetric one
+/// supported pairs: <double, double>, <float, float> and <float, double> (float samples, double coefficients and sums)
+/// @tparam Sample type of the samples
+/// @tparam Accumulator type of the coefficients and of the sums
+template <class Sample, class Accumulator = Sample>
+class BasicCascade {
+
+    private:
+
+    /// @brief the merged filter or one processor per stage
+    std::vector <BasicStreamingFIR <Sample, Accumulator>> m_stages;
+
+    /// @brief Merged or Staged
+    CascadeMethod m_method;
+
+    /// @brief size of the equivalent filter
+    size_t m_size;
+
+    /// @brief number of filters the cascade was created from
+    size_t m_stage_count;
+
+    /// @brief hot path counters, an empty type unless built with EASYDSP_INSTRUMENTATION
+    [[no_unique_address]] detail::Counters m_counters;
+
+    /// @brief constructor, validation must be handled by create()
+    BasicCascade(std::vector <BasicStreamingFIR <Sample, Accumulator>> stages, CascadeMethod method, size_t size, size_t stage_count);
+
+    public:
+
+    /// @brief number of samples every stage processes before the next stage runs in Staged mode
+    static constexpr size_t CASCADE_BLOCK_SIZE = 4096;
+
+    /// @brief creates a cascade
+    /// @param stages filters in the order they are applied, none may be nullptr
+    /// @param method CascadeMethod, Automatic compares the estimated cost of both
+    /// @return BasicCascade object on success, FIRError on failure
+    static std::expected <BasicCascade, FIRError> create(const std::vector <const FIR*>& stages, CascadeMethod method = CascadeMethod::Automatic);
+
+    /// @brief filters the next block of a continuous signal, every input sample produces one output sample
+    /// @param input input samples
+    /// @param output output samples, same size as input, may be the same buffer as input
+    /// @return void on success, FIRError on failure
+    std::expected <void, FIRError> process(std::span <const Sample> input, std::span <Sample> output);
+
+    /// @brief filters the next block of a continuous signal in place
+    /// @param signal samples to be filtered
+    /// @return void on success, FIRError on failure
+    std::expected <void, FIRError> processInPlace(std::span <Sample> signal);
+
+    /// @brief calulates the full convolution of signal with the cascade, the history of this object is not used or changed
+    /// @param signal input signal
+    /// @return vector of signal.size()+getSize()-1 samples on success, FIRError on failure
+    std::expected <std::vector <Sample>, FIRError> convolve(std::span <const Sample> signal) const;
+
+    /// @brief clears the history of every stage, as if no samples were processed yet
+    void reset() noexcept;
+
+    /// @brief counters of the process() calls
+    /// @return snapshot of the counters, all zero unless the library is built with EASYDSP_INSTRUMENTATION
+    FilterStats getStats() const noexcept;
+
+    /// @brief sets the counters to zero
+    void resetStats() noexcept;
+
+    /// @brief getter for size
+    /// @return size of the equivalent filter, sum of the sizes of the stages - (number of stages - 1)
+    size_t getSize() const noexcept;
+
+    /// @brief getter for stage count
+    /// @return number of filters the cascade was created from
+    size_t getStageCount() const noexcept;
+
+    /// @brief getter for method
+    /// @return Merged or Staged, never Automatic
+    CascadeMethod getMethod() const noexcept;
+
+};
+
+extern template class BasicCascade <double, double>;
+extern template class BasicCascade <float, float>;
+extern template class BasicCascade <float, double>;
+
+/// @brief cascade for double samples
+using Cascade = BasicCascade <double>;
+
+/// @brief cascade for float samples, float coefficients and sums
+using CascadeFloat = BasicCascade <float>;
+
+/// @brief cascade for float samples, double coefficients and sums
+using CascadeMixed = BasicCascade <float, double>;
+
+}
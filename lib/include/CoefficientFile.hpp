@@ -0,0 +1,95 @@
+#pragma once
+
+#include "FIR.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace oh::fir {
+
+///<    coefficient files store a designed filter so it can be loaded instead of designed again, all fields little endian:
+///<      0  magic "EDSPFIR\0"          8 bytes
+///<      8  version                    uint32, COEFFICIENT_FILE_VERSION
+///<     12  header size                uint32, 64
+///<     16  FIRType                    uint32
+///<     20  WindowType                 uint32
+///<     24  number of taps             uint64
+///<     32  offset of the taps         uint64, multiple of 64
+///<     40  number of parameters       uint64, getDesignParameters()
+///<     48  offset of the parameters   uint64, multiple of 64
+///<     56  flags                      uint32, bit 0: symmetric taps
+///<     60  checksum                   uint32, crc-32 of the whole file with this field set to 0
+///<    the taps and the parameters are arrays of double, each starts on a 64 byte boundary (zero padded),
+///<    so a mapped file can be read in place by aligned simd loads
+
+/// @brief current version of the coefficient file format, files of newer versions are refused
+constexpr uint32_t COEFFICIENT_FILE_VERSION = 1;
+
+/// @brief a filter rebuilt from a coefficient file
+/// the taps are used exactly as they were saved, the type, window and design parameters of the original filter are kept,
+/// setWindowType() only records the type, the taps stay as loaded
+class StoredFIR : public FIR {
+
+    private:
+
+    std::vector <double> m_parameters;
+
+    /// @brief constructor, validation must be handled by create()
+    /// @param type type of the original filter
+    /// @param size number of taps
+    /// @param w_type window of the original filter
+    /// @param parameters design parameters of the original filter
+    StoredFIR(FIRType type, size_t size, wnd::WindowType w_type, std::vector <double> parameters);
+
+    protected:
+
+    /// @brief keeps the stored taps
+    /// @return void
+    std::expected <void, FIRError> calculateCoefficients() override;
+
+    public:
+
+    /// @brief creates a filter from stored taps
+    /// @param type type of the original filter
+    /// @param w_type window of the original filter
+    /// @param taps coefficients, not empty
+    /// @param parameters design parameters of the original filter
+    /// @return StoredFIR object on success, FIRError on failure
+    static std::expected <StoredFIR, FIRError> create(FIRType type, wnd::WindowType w_type, std::span <const double> taps,
+                                                      std::vector <double> parameters);
+
+    /// @brief design parameters
+    /// @return parameters of the original filter
+    std::vector <double> getDesignParameters() const override;
+
+};
+
+/// @brief writes a filter to a coefficient file in memory
+/// @param fir filter to be saved
+/// @return contents of the file
+std::vector <std::byte> saveCoefficients(const FIR& fir);
+
+/// @brief writes a filter to a coefficient file, the file is written next to path and renamed,
+/// so readers never see a partly written file
+/// @param fir filter to be saved
+/// @param path file to be written (replaced if it exists)
+/// @return void on success, FileError on failure
+std::expected <void, FIRError> saveCoefficients(const FIR& fir, const std::filesystem::path& path);
+
+/// @brief rebuilds a filter from a coefficient file in memory, no design is calculated
+/// @param data contents of the file
+/// @return StoredFIR object on success, InvalidFileFormat for anything but a valid file of a known version,
+/// ChecksumMismatch if the contents were changed
+std::expected <StoredFIR, FIRError> loadCoefficients(std::span <const std::byte> data);
+
+/// @brief rebuilds a filter from a coefficient file, the file is memory-mapped and read in place, no design is calculated
+/// @param path file to be read
+/// @return StoredFIR object on success, FileError if it cannot be read, InvalidFileFormat for anything but a valid file
+/// of a known version, ChecksumMismatch if the contents were changed
+std::expected <StoredFIR, FIRError> loadCoefficients(const std::filesystem::path& path);
+
+}
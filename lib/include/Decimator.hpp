@@ -0,0 +1,111 @@
+#pragma once
+
+#include "FIR.hpp"
+
+#include <vector>
+#include <cstddef>
+#include <expected>
+#include <span>
+
+namespace oh::fir {
+
+/// @brief a stateful polyphase decimator: filters the signal and keeps every factor-th sample
+/// only the kept outputs are calculated, the coefficients are split into factor phases which run on the matching
+/// phases of the input, so one output costs size multiplies (size/factor per input sample)
+/// the first input sample produces the first output, y[m] = sum h[k] * x[m*factor - k]
+/// supported pairs: <double, double>, <float, float> and <float, double> (float samples, double coefficients and sums)
+/// @tparam Sample type of the samples
+/// @tparam Accumulator type of the coefficients and of the sums
+template <class Sample, class Accumulator = Sample>
+class BasicDecimator {
+
+    private:
+
+    size_t m_factor;
+
+    size_t m_size;
+
+    /// @brief number of coefficients of every phase
+    size_t m_phase_length;
+
+    /// @brief reversed coefficients split into factor phases, padded in front with zeros to factor*m_phase_length
+    std::vector <Accumulator> m_phases;
+
+    /// @brief working buffer: factor*m_phase_length-1 samples of history followed by room for one chunk of input
+    std::vector <Sample> m_buffer;
+
+    ///<    one phase of the input of a chunk, the outputs of that phase and the sum of the phases so far,
+    ///<    all in the accumulator type, so the phases are added without rounding to Sample in between
+
+    std::vector <Accumulator> m_phase_input;
+    std::vector <Accumulator> m_phase_output;
+    std::vector <Accumulator> m_phase_sum;
+
+    /// @brief number of input samples per pass over the buffer
+    size_t m_chunk_size;
+
+    /// @brief number of input samples to skip before the next sample that produces an output
+    size_t m_skip;
+
+    /// @brief constructor, validation must be handled by create()
+    /// @param coefficients coefficients of the filter
+    /// @param factor decimation factor
+    BasicDecimator(const std::vector <double>& coefficients, size_t factor);
+
+    /// @brief filters the chunk in the buffer and writes its outputs
+    /// @param output pointer to the outputs
+    /// @param count number of new input samples in the buffer
+    /// @return number of outputs written
+    size_t processChunk(Sample* output, size_t count) noexcept;
+
+    public:
+
+    /// @brief creates a decimator
+    /// @param fir anti-alias filter, its gain above 0.5/factor must be at least 3 dB below its peak
+    /// @param factor decimation factor, nonzero
+    /// @return BasicDecimator object on success, FIRError on failure
+    static std::expected <BasicDecimator, FIRError> create(const FIR& fir, size_t factor);
+
+    /// @brief number of outputs the next process() call produces for a given number of input samples
+    /// @param input_size number of input samples
+    /// @return number of outputs
+    size_t getOutputSize(size_t input_size) const noexcept;
+
+    /// @brief filters and decimates a block of samples (any size), the state is carried over to the next call
+    /// @param input block of input samples
+    /// @param output at least getOutputSize(input.size()) samples, must not overlap the input
+    /// @return number of outputs written on success, FIRError on failure
+    std::expected <size_t, FIRError> process(std::span <const Sample> input, std::span <Sample> output);
+
+    /// @brief filters and decimates a block of samples (any size), the state is carried over to the next call
+    /// @param input block of input samples
+    /// @return vector of getOutputSize(input.size()) outputs on success, FIRError on failure
+    std::expected <std::vector <Sample>, FIRError> process(const std::vector <Sample>& input);
+
+    /// @brief clears the history, as if no samples were processed yet
+    void reset() noexcept;
+
+    /// @brief getter for factor
+    /// @return decimation factor
+    size_t getFactor() const noexcept;
+
+    /// @brief getter for size
+    /// @return size of the filter
+    size_t getSize() const noexcept;
+
+};
+
+extern template class BasicDecimator <double, double>;
+extern template class BasicDecimator <float, float>;
+extern template class BasicDecimator <float, double>;
+
+/// @brief decimator for double samples
+using Decimator = BasicDecimator <double>;
+
+/// @brief decimator for float samples, float coefficients and sums
+using DecimatorFloat = BasicDecimator <float>;
+
+/// @brief decimator for float samples, double coefficients and sums
+using DecimatorMixed = BasicDecimator <float, double>;
+
+}
@@ -1,10 +1,28 @@
-#pragma once
-
-///<    include this file to get all others
-
-#include "FIR.hpp"
-#include "WindowLowpass.hpp"
-#include "WindowBandpass.hpp"
-#include "WindowHighpass.hpp"
-#include "FrequencySampling.hpp"
-#include "Window.hpp"
\ No newline at end of file
+#pragma once
+
+///<    include this file to get all others
+
+#include "FIR.hpp"
+#include "WindowLowpass.hpp"
+#include "WindowBandpass.hpp"
+#include "WindowHighpass.hpp"
+#include "FrequencySampling.hpp"
+#include "Window.hpp"
+#include "StreamingFIR.hpp"
+#include "PartitionedConvolver.hpp"
+#include "FixedPointFIR.hpp"
+#include "FixedFIR.hpp"
+#include "MultichannelFIR.hpp"
+#include "FilterBank.hpp"
+#include "Decimator.hpp"
+#include "Interpolator.hpp"
+#include "Resampler.hpp"
+#include "Executor.hpp"
+#include "SampleFormat.hpp"
+#include "WavFile.hpp"
+#include "FileFilter.hpp"
+#include "CoefficientFile.hpp"
+#include "FilterRegistry.hpp"
+#include "Cascade.hpp"
+#include "Instrumentation.hpp"
+#include "SIMD.hpp"
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace oh::fir {
+
+/// @brief runs task(0) to task(count-1) and returns when all of them have finished, the tasks may run in parallel
+/// any thread pool can be plugged in by wrapping it in this signature
+using Executor = std::function <void(size_t count, const std::function <void(size_t)>& task)>;
+
+/// @brief executor that runs the tasks on threads started for the call, the calling thread is one of them,
+/// every thread takes the next task as soon as it is done with the previous one
+/// @param threads number of threads, 0 uses std::thread::hardware_concurrency()
+/// @return Executor
+Executor makeThreadExecutor(size_t threads = 0);
+
+/// @brief executor that runs every task on the calling thread, in order
+/// @return Executor
+Executor makeSerialExecutor();
+
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Window.hpp"
+#include "Executor.hpp"
+#include "Instrumentation.hpp"
 
 #include <cmath>
 #include <vector>
@@ -8,6 +10,11 @@
 #include <cstddef>
 #include <expected>
 #include <string>
+#include <span>
+#include <iterator>
+#include <memory>
+#include <concepts>
+#include <type_traits>
 
 
 
@@ -18,7 +25,8 @@ enum class FIRType {
     WindowLowpass,
     WindowHighpass,
     WindowBandpass,
-    FrequencySampling
+    FrequencySampling,
+    Fixed
 };
 
 /// @brief enum used for error handling
@@ -28,7 +36,17 @@ enum class FIRError {
     InvalidParameterValue,
     InvalidParameterOrder,
     NormalisationFailed,
-    WindowError
+    WindowError,
+    FileError,              ///<    a file could not be opened, mapped, read or written
+    InvalidFileFormat,      ///<    a file was read but its contents are not in the expected format
+    ChecksumMismatch        ///<    the contents of a file do not match its checksum
+};
+
+/// @brief enum used to choose how the convolution is calculated
+enum class ConvolutionMethod {
+    Automatic,
+    Direct,
+    FFT
 };
 
 ///<    debugging and error handling
@@ -43,8 +61,19 @@ std::string toString(oh::fir::FIRError fir_error);
 /// @return string
 std::string toString(oh::fir::FIRType fir_type);
 
+/// @brief used to translate ConvolutionMethod to std::string
+/// @param method 
+/// @return string
+std::string toString(oh::fir::ConvolutionMethod method);
+
 
 
+namespace detail {
+
+struct FilterTaps;
+
+}
+
 /// @brief a class used as a template to implement more specific FIR filters
 class FIR {     
     
@@ -55,8 +84,23 @@ class FIR {
 
     wnd::WindowType m_window_type;
 
-    /// @brief stores the coefficients of the filter
-    std::vector <double> m_coefficients;
+    /// @brief number of coefficients
+    size_t m_size;
+
+    /// @brief immutable coefficients with the (aligned) reversed copies used by the kernels, made once in setCoefficients(),
+    /// copies of the filter share them, so copying a filter does not copy its taps
+    std::shared_ptr <const detail::FilterTaps> m_taps;
+
+    /// @brief hot path counters, an empty type unless built with EASYDSP_INSTRUMENTATION
+    [[no_unique_address]] mutable detail::Counters m_counters;
+
+    /// @brief writes the size+getSize()-1 outputs of the convolution to output, shared by every convolve() overload
+    /// @param signal pointer to the input signal
+    /// @param size number of input samples, nonzero
+    /// @param output pointer to size+getSize()-1 output samples, must not overlap the signal
+    /// @param method ConvolutionMethod
+    template <class Sample, class Accumulator>
+    void convolveTo(const Sample* signal, size_t size, Sample* output, ConvolutionMethod method) const;
 
     protected:
 
@@ -99,7 +143,8 @@ class FIR {
     FIR(FIRType fir_type, size_t size, wnd::WindowType win_type);
 
 
-    /// @brief protected setter for coefficients
+    /// @brief protected setter for coefficients, also checks if they are symmetric
+    /// pairs that differ only by rounding (up to 1e-12 of the largest coefficient) are made exactly equal
     /// @param coefficients the coefficients to be set
     /// @return void on success, FIRError on failure
     std::expected <void, FIRError> setCoefficients(const std::vector <double>& coefficients);
@@ -117,24 +162,51 @@ class FIR {
 
     ///<    getters
 
-    /// @brief getter for coefficients
-    /// @return m_coefficients
+    /// @brief getter for coefficients, copies of a filter return the same (shared) vector
+    /// @return coefficients
     const std::vector <double>& getCoefficients() const;
 
+    /// @brief getter for the coefficients the convolution kernels read
+    /// @return coefficients in reversed order, for symmetric filters with mirrored pairs that differ only by rounding
+    /// replaced by their mean, empty if the filter has no coefficients
+    std::span <const double> getKernelCoefficients() const noexcept;
+
+    /// @brief tells if two filters share one tap buffer, e.g. copies of each other or handles of a FilterRegistry
+    /// @param other filter to compare with
+    /// @return true if the coefficients of both are the same object
+    bool sharesCoefficients(const FIR& other) const noexcept;
+
 
     /// @brief getter for size
-    /// @return size of m_coefficients
+    /// @return number of coefficients
     size_t getSize() const noexcept;
 
     /// @brief getter for type
     /// @return type of filter
     FIRType getType() const noexcept;
 
+    /// @brief tells if the coefficients are symmetric, symmetric filters use folded kernels with half the multiplies
+    /// @return true if h[n] == h[size-1-n] for all n
+    bool isSymmetric() const noexcept;
+
+
+    /// @brief counters of the convolve() calls of this filter (convolveInPlace() and convolveParallel() included),
+    /// copies of a filter start with the counters of the original
+    /// @return snapshot of the counters, all zero unless the library is built with EASYDSP_INSTRUMENTATION
+    FilterStats getStats() const noexcept;
+
+    /// @brief sets the counters to zero, they are not part of the filter, so this works on const filters too
+    void resetStats() const noexcept;
 
     /// @brief getter for WindowType
     /// @return type of window
     wnd::WindowType getWindowType() const noexcept;
 
+    /// @brief parameters the coefficients were designed from, together with type, size and window they define the filter
+    /// e.g. {fc} for lowpass and highpass, {fc_low, fc_high} for bandpass, the half spectrum for frequency sampling
+    /// @return parameters, empty for filters given by their taps
+    virtual std::vector <double> getDesignParameters() const;
+
     /// @brief set and apply new window (regenerates coefficients)
     /// @param w_type type of window
     /// @return void on success, FIRError on failure
@@ -147,11 +219,116 @@ class FIR {
     /// @return vector containing convluted signal(copy)
     std::expected <std::vector<double>, FIRError> convolve(const std::vector<double>& signal) const;
 
+    /// @brief calulates the convolution of signal with the filter using the chosen method
+    /// Automatic picks the fft (overlap-save) when it is estimated to be cheaper than the direct loop
+    /// @param signal input signal
+    /// @param method ConvolutionMethod
+    /// @return vector containing convluted signal(copy)
+    std::expected <std::vector<double>, FIRError> convolve(const std::vector<double>& signal, ConvolutionMethod method) const;
+
+    /// @brief calulates the convolution of a float or double signal without converting it
+    /// supported pairs: <double, double>, <float, float> and <float, double> (float signal, double coefficients and sums)
+    /// @tparam Sample type of the signal
+    /// @tparam Accumulator type of the coefficients and of the sums
+    /// @param signal input signal
+    /// @param method ConvolutionMethod
+    /// @return vector containing convluted signal(copy)
+    template <class Sample, class Accumulator = Sample>
+    std::expected <std::vector <Sample>, FIRError> convolve(const std::vector <Sample>& signal, ConvolutionMethod method = ConvolutionMethod::Automatic) const;
+
+    ///<    allocation free convolution into memory owned by the caller
+    ///<    these overloads default to the direct kernels, which never allocate; Automatic or FFT may pick the fft path,
+    ///<    which builds its engine and a padded copy of the signal on every call,
+    ///<    use StreamingFIR (which keeps its engine) to filter long signals in a loop
+
+    /// @brief calulates the convolution of signal with the filter into a caller provided buffer
+    /// @param signal input signal
+    /// @param output at least signal.size()+getSize()-1 samples, must not overlap the signal
+    /// @param method ConvolutionMethod, Direct by default so nothing is allocated
+    /// @return number of samples written on success, FIRError on failure
+    std::expected <size_t, FIRError> convolve(std::span <const double> signal, std::span <double> output,
+                                              ConvolutionMethod method = ConvolutionMethod::Direct) const;
+
+    /// @brief float version, the sums are calculated in float
+    std::expected <size_t, FIRError> convolve(std::span <const float> signal, std::span <float> output,
+                                              ConvolutionMethod method = ConvolutionMethod::Direct) const;
+
+    /// @brief calulates the convolution into a caller provided buffer with an explicit accumulator, e.g. convolve <float, double> (in, out)
+    /// @tparam Sample type of the signal
+    /// @tparam Accumulator type of the coefficients and of the sums
+    /// @param signal input signal
+    /// @param output at least signal.size()+getSize()-1 samples, must not overlap the signal
+    /// @param method ConvolutionMethod, Direct by default so nothing is allocated
+    /// @return number of samples written on success, FIRError on failure
+    template <class Sample, class Accumulator = Sample>
+    std::expected <size_t, FIRError> convolve(std::span <const std::type_identity_t <Sample>> signal, std::span <std::type_identity_t <Sample>> output,
+                                              ConvolutionMethod method = ConvolutionMethod::Direct) const;
+
+    /// @brief iterator form of the caller provided buffer convolution, like std::copy the output range must be large enough
+    /// @param first begin of the input signal
+    /// @param last end of the input signal
+    /// @param out begin of the output, room for (last-first)+getSize()-1 samples
+    /// @param method ConvolutionMethod, Direct by default so nothing is allocated
+    /// @return iterator past the last written sample on success, FIRError on failure
+    template <std::contiguous_iterator InputIt, std::contiguous_iterator OutputIt>
+    requires std::same_as <std::iter_value_t <InputIt>, std::iter_value_t <OutputIt>>
+    std::expected <OutputIt, FIRError> convolve(InputIt first, InputIt last, OutputIt out,
+                                                ConvolutionMethod method = ConvolutionMethod::Direct) const {
+        using Sample = std::iter_value_t <InputIt>;
+        const size_t size = static_cast <size_t> (last - first);
+        std::span <const Sample> signal(std::to_address(first), size);
+        std::span <Sample> output(std::to_address(out), size == 0 ? 0 : size + getSize() - 1);
+
+        if (auto w = convolve <Sample> (signal, output, method); !w) {
+            return std::unexpected(w.error());
+        } else {
+            return out + static_cast <std::iter_difference_t <OutputIt>> (*w);
+        }
+    }
+
+    ///<    parallel convolution for very large signals: the outputs are split into chunks (each reading its own
+    ///<    size-1 samples of overlap) which are written straight into the destination by several threads,
+    ///<    chunks start at multiples of the kernel blocks and fft blocks, so the result is identical to convolve()
+
+    /// @brief calulates the convolution on threads started for the call
+    /// @param signal input signal
+    /// @param output at least signal.size()+getSize()-1 samples, must not overlap the signal
+    /// @param threads number of threads, 0 uses std::thread::hardware_concurrency()
+    /// @param method ConvolutionMethod
+    /// @return number of samples written on success, FIRError on failure
+    std::expected <size_t, FIRError> convolveParallel(std::span <const double> signal, std::span <double> output, size_t threads = 0,
+                                                      ConvolutionMethod method = ConvolutionMethod::Automatic) const;
+
+    /// @brief float version, the sums are calculated in float
+    std::expected <size_t, FIRError> convolveParallel(std::span <const float> signal, std::span <float> output, size_t threads = 0,
+                                                      ConvolutionMethod method = ConvolutionMethod::Automatic) const;
+
+    /// @brief calulates the convolution with the chunks run by a caller provided executor (e.g. an existing thread pool)
+    /// @tparam Sample type of the signal
+    /// @tparam Accumulator type of the coefficients and of the sums
+    /// @param signal input signal
+    /// @param output at least signal.size()+getSize()-1 samples, must not overlap the signal
+    /// @param executor runs the chunks, must not be empty
+    /// @param method ConvolutionMethod
+    /// @return number of samples written on success, FIRError on failure
+    template <class Sample, class Accumulator = Sample>
+    std::expected <size_t, FIRError> convolveParallel(std::span <const std::type_identity_t <Sample>> signal, std::span <std::type_identity_t <Sample>> output,
+                                                      const Executor& executor, ConvolutionMethod method = ConvolutionMethod::Automatic) const;
+
     /// @brief calulates the convolution of signal with the filter
     /// @param signal input signal
-    /// @return vector containing convluted signal(overriden)
+    /// @return copy of the convluted signal on success, FIRError on failure, signal is overriden with the convluted signal
+    /// the returned vector is a second copy of the result, use the overload with a ConvolutionMethod to avoid it
     std::expected <std::vector<double>, FIRError> convolveInPlace(std::vector<double>& signal) const;
 
+    /// @brief calulates the convolution of signal with the filter and replaces signal with it
+    /// @param signal input signal, holds signal.size()+getSize()-1 samples afterwards
+    /// @param method ConvolutionMethod
+    /// @return void on success, FIRError on failure (signal is left unchanged)
+    /// the result is computed into a new buffer which is swapped into signal, so every call still allocates once,
+    /// hot loops should use the std::span overload of convolve() with an output buffer that is reused
+    std::expected <void, FIRError> convolveInPlace(std::vector<double>& signal, ConvolutionMethod method) const;
+
     /// @brief destructor
     virtual ~FIR() = default;
 
@@ -161,6 +338,16 @@ class FIR {
 
 };
 
+extern template std::expected <std::vector <double>, FIRError> FIR::convolve <double, double> (const std::vector <double>&, ConvolutionMethod) const;
+extern template std::expected <std::vector <float>, FIRError> FIR::convolve <float, float> (const std::vector <float>&, ConvolutionMethod) const;
+extern template std::expected <std::vector <float>, FIRError> FIR::convolve <float, double> (const std::vector <float>&, ConvolutionMethod) const;
+extern template std::expected <size_t, FIRError> FIR::convolve <double, double> (std::span <const double>, std::span <double>, ConvolutionMethod) const;
+extern template std::expected <size_t, FIRError> FIR::convolve <float, float> (std::span <const float>, std::span <float>, ConvolutionMethod) const;
+extern template std::expected <size_t, FIRError> FIR::convolve <float, double> (std::span <const float>, std::span <float>, ConvolutionMethod) const;
+extern template std::expected <size_t, FIRError> FIR::convolveParallel <double, double> (std::span <const double>, std::span <double>, const Executor&, ConvolutionMethod) const;
+extern template std::expected <size_t, FIRError> FIR::convolveParallel <float, float> (std::span <const float>, std::span <float>, const Executor&, ConvolutionMethod) const;
+extern template std::expected <size_t, FIRError> FIR::convolveParallel <float, double> (std::span <const float>, std::span <float>, const Executor&, ConvolutionMethod) const;
+
 }
 
 
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "FIR.hpp"
+#include "SampleFormat.hpp"
+#include "WavFile.hpp"
+
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <optional>
+
+namespace oh::fir {
+
+/// @brief settings of filterRawFile()
+struct RawFileOptions {
+    SampleFormat input_format = SampleFormat::Float32;
+    SampleFormat output_format = SampleFormat::Float32;     ///<    integer outputs are rounded and saturated
+    size_t channels = 1;                    ///<    interleaved channels, every channel is filtered on its own
+    size_t header_bytes = 0;                ///<    bytes at the start of the input that are skipped (not copied)
+    size_t block_frames = 64 * 1024;        ///<    frames read, filtered and written per pass, sets the memory in use
+    bool tail = false;                      ///<    also write the getSize()-1 frames of decay after the input ends
+};
+
+/// @brief filters a raw sample file of any size into another file without loading it
+/// the input is memory-mapped and read front to back, block_frames frames at a time, with the history of the filter
+/// carried across block edges, pages already read are released and the output is written sequentially,
+/// so the memory in use depends on block_frames and the filter, not on the file
+/// the result equals the first frames (all of them with tail) of convolve() on every channel, calculated in double
+/// @param fir filter to be used
+/// @param input raw file of interleaved frames, its size after the header must be a multiple of the frame size
+/// @param output file to be written (replaced if it exists), must not be the input
+/// @param options formats, layout and block size
+/// @return number of frames written on success, FIRError on failure (FileError if a file cannot be read or written)
+std::expected <size_t, FIRError> filterRawFile(const FIR& fir, const std::filesystem::path& input, const std::filesystem::path& output,
+                                               const RawFileOptions& options = {});
+
+/// @brief settings of filterWavFile()
+struct WavFileOptions {
+    std::optional <SampleFormat> output_format;     ///<    sample format of the output, the one of the input if not set
+    size_t block_frames = 64 * 1024;        ///<    frames read, filtered and written per pass, sets the memory in use
+    bool tail = false;                      ///<    also write the getSize()-1 frames of decay after the input ends
+};
+
+/// @brief filters a wav file of any size into another wav file without loading it
+/// the input is read with a WavReader block_frames frames at a time, filtered with the history carried across block edges
+/// and appended to a WavWriter, the output has the sample rate and channels of the input
+/// the result equals the first frames (all of them with tail) of convolve() on every channel, calculated in double
+/// @param fir filter to be used
+/// @param input wav file, see WavReader::open() for the supported formats
+/// @param output wav file to be written (replaced if it exists), must not be the input
+/// @param options output format and block size
+/// @return number of frames written on success, FIRError on failure
+std::expected <size_t, FIRError> filterWavFile(const FIR& fir, const std::filesystem::path& input, const std::filesystem::path& output,
+                                               const WavFileOptions& options = {});
+
+}
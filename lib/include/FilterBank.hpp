@@ -0,0 +1,121 @@
+#pragma once
+
+#include "FIR.hpp"
+#include "Executor.hpp"
+
+#include <vector>
+#include <cstddef>
+#include <expected>
+#include <span>
+
+namespace oh::fir {
+
+/// @brief runs many filters (of any lengths) over the same input
+/// the input is walked once in tiles small enough for the L1 cache, every filter reads the tile while it is hot,
+/// large banks can split the filters across threads, or across the tasks of a caller provided executor
+/// supported pairs: <double, double>, <float, float> and <float, double> (float samples, double coefficients and sums)
+/// @tparam Sample type of the samples
+/// @tparam Accumulator type of the coefficients and of the sums
+template <class Sample, class Accumulator = Sample>
+class BasicFilterBank {
+
+    private:
+
+    /// @brief reversed coefficients of every filter, one after another
+    std::vector <Accumulator> m_reversed_coefficients;
+
+    /// @brief index of the first coefficient of every filter in m_reversed_coefficients
+    std::vector <size_t> m_offsets;
+
+    std::vector <size_t> m_sizes;
+
+    std::vector <bool> m_symmetric;
+
+    size_t m_max_size;
+
+    size_t m_threads;
+
+    /// @brief runs the ranges of filters of convolve()
+    Executor m_executor;
+
+    /// @brief constructor, validation must be handled by create()
+    /// @param filters filters of the bank
+    /// @param executor runs the ranges of filters
+    /// @param threads number of ranges the filters are split into
+    BasicFilterBank(const std::vector <const FIR*>& filters, Executor executor, size_t threads);
+
+    /// @brief filters the zero padded input with the filters [first, last), tile by tile
+    /// @param padded input with getMaxSize()-1 zeros in front and behind
+    /// @param size number of input samples
+    /// @param rows output pointer of every filter
+    /// @param first first filter
+    /// @param last one past the last filter
+    void run(const Sample* padded, size_t size, Sample* const* rows, size_t first, size_t last) const noexcept;
+
+    /// @brief pads the input and runs every filter, split into ranges run by the executor
+    /// @param signal input signal
+    /// @param rows output pointer of every filter, signal.size()+getSize(k)-1 samples each
+    void runAll(std::span <const Sample> signal, Sample* const* rows) const;
+
+    public:
+
+    /// @brief creates a filter bank, the coefficients are copied in the Accumulator type
+    /// @param filters filters of the bank, none may be nullptr
+    /// @param threads number of threads used by convolve(), 1 keeps everything on the calling thread
+    /// @return BasicFilterBank object on success, FIRError on failure
+    static std::expected <BasicFilterBank, FIRError> create(const std::vector <const FIR*>& filters, size_t threads = 1);
+
+    /// @brief creates a filter bank whose convolve() runs on a caller provided executor (e.g. an existing thread pool)
+    /// @param filters filters of the bank, none may be nullptr
+    /// @param executor runs the ranges of filters, must not be empty
+    /// @param threads number of ranges with about the same number of multiply-adds the filters are split into,
+    /// usually the number of threads of the executor
+    /// @return BasicFilterBank object on success, FIRError on failure
+    static std::expected <BasicFilterBank, FIRError> create(const std::vector <const FIR*>& filters, Executor executor, size_t threads);
+
+    /// @brief calulates the convolution of signal with every filter
+    /// @param signal input signal
+    /// @return one vector per filter, filter k gives signal.size()+getSize(k)-1 samples
+    std::expected <std::vector <std::vector <Sample>>, FIRError> convolve(std::span <const Sample> signal) const;
+
+    /// @brief calulates the convolution of signal with every filter into a packed matrix
+    /// row k starts at k*(signal.size()+getMaxSize()-1) and holds the signal.size()+getSize(k)-1 outputs of filter k,
+    /// followed by zeros up to the row length
+    /// @param signal input signal
+    /// @param output at least getFilterCount()*(signal.size()+getMaxSize()-1) samples, must not overlap the signal
+    /// @return row length on success, FIRError on failure
+    std::expected <size_t, FIRError> convolve(std::span <const Sample> signal, std::span <Sample> output) const;
+
+    /// @brief getter for filter count
+    /// @return number of filters in the bank
+    size_t getFilterCount() const noexcept;
+
+    /// @brief getter for size of one filter
+    /// @param filter index of the filter
+    /// @return size of the filter, 0 if the index is out of range
+    size_t getSize(size_t filter) const noexcept;
+
+    /// @brief getter for max size
+    /// @return size of the longest filter
+    size_t getMaxSize() const noexcept;
+
+    /// @brief getter for thread count
+    /// @return number of threads (ranges of filters) used by convolve()
+    size_t getThreadCount() const noexcept;
+
+};
+
+extern template class BasicFilterBank <double, double>;
+extern template class BasicFilterBank <float, float>;
+extern template class BasicFilterBank <float, double>;
+
+/// @brief filter bank for double samples
+using FilterBank = BasicFilterBank <double>;
+
+/// @brief filter bank for float samples, float coefficients and sums
+using FilterBankFloat = BasicFilterBank <float>;
+
+/// @brief filter bank for float samples, double coefficients and sums
+using FilterBankMixed = BasicFilterBank <float, double>;
+
+}
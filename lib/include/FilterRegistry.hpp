@@ -0,0 +1,115 @@
+#pragma once
+
+#include "FIR.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace oh::fir {
+
+/// @brief handle of a filter kept by a FilterRegistry, cheap to copy, the filter is immutable,
+/// so one handle can be convolved with from many threads at once
+using FilterHandle = std::shared_ptr <const FIR>;
+
+/// @brief interns filters: equal designs (type, window, size and design parameters) are stored once and every request
+/// returns a handle to the same filter, so the taps take memory once per unique design however many modules ask for it
+/// the registry keeps weak references only, a design is freed with its last handle (and designed again if it is requested
+/// after that), all methods are thread-safe
+class FilterRegistry {
+
+    private:
+
+    struct Key {
+        FIRType type;
+        wnd::WindowType window;
+        size_t size;
+        std::vector <uint64_t> parameters;              ///<    bit patterns of getDesignParameters(), designs match only if identical
+
+        auto operator<=>(const Key&) const = default;
+    };
+
+    mutable std::mutex m_mutex;
+
+    std::multimap <Key, std::weak_ptr <const FIR>> m_filters;
+
+    /// @brief the entries of freed filters are removed once the map grows to this size
+    size_t m_prune_at = 16;
+
+    /// @brief key of a design
+    static Key makeKey(FIRType type, wnd::WindowType w_type, size_t size, const std::vector <double>& parameters);
+
+    /// @brief finds a live filter of the key
+    /// @param match if not null, only a filter with the same coefficients is returned
+    /// @return handle, empty if there is none
+    FilterHandle find(const Key& key, const FIR* match) const;
+
+    /// @brief registers a filter unless a live filter of the key (with the same coefficients if match_coefficients) exists
+    /// @return the registered filter, fir or the one found
+    FilterHandle insert(Key key, FilterHandle fir, bool match_coefficients);
+
+    /// @brief returns the filter of the key or registers the one created by create(), which is only called when needed
+    template <class Create>
+    std::expected <FilterHandle, FIRError> findOrCreate(Key key, Create&& create);
+
+    public:
+
+    FilterRegistry() = default;
+    FilterRegistry(const FilterRegistry&) = delete;
+    FilterRegistry& operator=(const FilterRegistry&) = delete;
+
+    /// @brief the registry shared by the whole process
+    /// @return registry
+    static FilterRegistry& global();
+
+    /// @brief windowed sinc lowpass, see WindowLowpass::create()
+    /// @param fc normalised cutoff frequency
+    /// @param size number of taps, odd
+    /// @param w_type type of window
+    /// @return handle on success, FIRError on failure
+    std::expected <FilterHandle, FIRError> lowpass(double fc, size_t size, wnd::WindowType w_type = wnd::WindowType::Rectangular);
+
+    /// @brief windowed sinc highpass, see WindowHighpass::create()
+    /// @param fc normalised cutoff frequency
+    /// @param size number of taps, odd
+    /// @param w_type type of window
+    /// @return handle on success, FIRError on failure
+    std::expected <FilterHandle, FIRError> highpass(double fc, size_t size, wnd::WindowType w_type = wnd::WindowType::Rectangular);
+
+    /// @brief windowed sinc bandpass, see WindowBandpass::create()
+    /// @param fc_low lower normalised cutoff frequency
+    /// @param fc_high higher normalised cutoff frequency
+    /// @param size number of taps, odd
+    /// @param w_type type of window
+    /// @return handle on success, FIRError on failure
+    std::expected <FilterHandle, FIRError> bandpass(double fc_low, double fc_high, size_t size,
+                                                    wnd::WindowType w_type = wnd::WindowType::Rectangular);
+
+    /// @brief frequency sampling design, see FrequencySampling::create()
+    /// @param half_frequency_spectrum amplitudes of the bins from dc up
+    /// @return handle on success, FIRError on failure
+    std::expected <FilterHandle, FIRError> frequencySampling(const std::vector <double>& half_frequency_spectrum);
+
+    /// @brief registers an already created filter, e.g. a FixedFIR or a StoredFIR from loadCoefficients()
+    /// a live filter of the same design and with the same coefficients is returned instead if there is one
+    /// @tparam Filter concrete type of the filter
+    /// @param fir filter, moved into the registry
+    /// @return handle
+    template <std::derived_from <FIR> Filter>
+    FilterHandle intern(Filter fir) {
+        Key key = makeKey(fir.getType(), fir.getWindowType(), fir.getSize(), fir.getDesignParameters());
+        return insert(std::move(key), std::make_shared <const Filter> (std::move(fir)), true);
+    }
+
+    /// @brief number of filters alive
+    /// @return number of registered filters still held by a handle
+    size_t size() const;
+
+};
+
+}
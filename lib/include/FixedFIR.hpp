@@ -0,0 +1,486 @@
+#pragma once
+
+#include "FIR.hpp"
+
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <expected>
+#include <span>
+#include <utility>
+#include <numbers>
+#include <algorithm>
+#include <type_traits>
+
+namespace oh::fir {
+
+namespace detail {
+
+///<    std::sin and std::cos are not constexpr, these reduce the argument to [-pi/2, pi/2] and sum the taylor series,
+///<    the compile time designs agree with the runtime ones to about 1e-15
+
+/// @brief x reduced to [-pi, pi], 2*pi is split in two parts so large arguments keep their precision
+constexpr double reducePhase(double x) noexcept {
+    constexpr double two_pi_high = 6.28318530717958623199592693709;
+    constexpr double two_pi_low = 2.44929359829470635445e-16;
+    const double turns = x / (2.0 * std::numbers::pi);
+    const double k = static_cast <double> (static_cast <long long> (turns >= 0.0 ? turns + 0.5 : turns - 0.5));
+    return (x - k * two_pi_high) - k * two_pi_low;
+}
+
+/// @brief constexpr sine
+constexpr double sin(double x) noexcept {
+    double r = reducePhase(x);
+    if (r > std::numbers::pi / 2) {
+        r = std::numbers::pi - r;
+    } else if (r < -std::numbers::pi / 2) {
+        r = -std::numbers::pi - r;
+    }
+
+    const double r2 = r * r;
+    double term = r;
+    double sum = r;
+    for (int k = 1; k < 13; ++k) {
+        term *= -r2 / ((2 * k) * (2 * k + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+/// @brief constexpr cosine
+constexpr double cos(double x) noexcept {
+    double r = reducePhase(x);
+    double sign = 1.0;
+    if (r > std::numbers::pi / 2) {
+        r = std::numbers::pi - r;
+        sign = -1.0;
+    } else if (r < -std::numbers::pi / 2) {
+        r = -std::numbers::pi - r;
+        sign = -1.0;
+    }
+
+    const double r2 = r * r;
+    double term = 1.0;
+    double sum = 1.0;
+    for (int k = 1; k < 13; ++k) {
+        term *= -r2 / ((2 * k - 1) * (2 * k));
+        sum += term;
+    }
+    return sign * sum;
+}
+
+/// @brief constexpr version of FIR::sinc()
+constexpr double sinc(double x) noexcept {
+    const double eps = 1e-12;
+    if (x < eps && x > -eps) {
+        return 1.0;
+    } else {
+        return detail::sin(std::numbers::pi * x) / (std::numbers::pi * x);
+    }
+}
+
+/// @brief constexpr version of the window formulas in wnd::Window
+/// @return window coefficient n of a window of size N, or an error for unknown types
+constexpr std::expected <double, FIRError> windowValue(wnd::WindowType w_type, size_t n, size_t N) noexcept {
+    const double x = 2.0 * std::numbers::pi * n / (N - 1);
+
+    switch (w_type) {
+        case wnd::WindowType::Rectangular:
+            return 1.0;
+        case wnd::WindowType::Hamming:
+            return 0.54 - 0.46 * detail::cos(x);
+        case wnd::WindowType::Hanning:
+            return 0.5 * (1.0 - detail::cos(x));
+        case wnd::WindowType::Blackman:
+            return 0.42 - 0.50 * detail::cos(x) + 0.08 * detail::cos(2.0 * x);
+        default:
+            return std::unexpected(FIRError::WindowError);
+    }
+}
+
+/// @brief windowed design shared by the constexpr designers, the second half is mirrored so the taps are exactly symmetric
+/// @param response ideal impulse response at offset n-(N-1)/2 from the centre
+template <size_t N, class Response>
+constexpr std::expected <std::array <double, N>, FIRError> designWindowed(wnd::WindowType w_type, Response response) noexcept {
+    static_assert(N >= 3 && N % 2 == 1, "the size of a window design must be odd and at least 3");
+
+    std::array <double, N> h{};
+    const double M = (N - 1) / 2.0;
+
+    for (size_t n = 0; n <= N / 2; ++n) {
+        auto w = windowValue(w_type, n, N);
+        if (!w) {
+            return std::unexpected(w.error());
+        }
+        h[n] = response(n - M) * (*w);
+        h[N - 1 - n] = h[n];
+    }
+
+    return h;
+}
+
+///<    the tap loop is a fold expression over the tap indices, so the compiler sees N straight-line steps with constant
+///<    offsets, every step updates a block of consecutive outputs, which maps onto simd registers of any width
+
+/// @brief number of outputs calculated together, 128 bytes of sums (four avx registers)
+template <class Accumulator>
+inline constexpr size_t UNROLLED_BLOCK = 128 / sizeof(Accumulator);
+
+template <size_t W, class Sample, class Accumulator>
+constexpr void unrolledStep(Accumulator* sum, Accumulator h, const Sample* x) noexcept {
+    for (size_t w = 0; w < W; ++w) {
+        sum[w] += h * static_cast <Accumulator> (x[w]);
+    }
+}
+
+template <size_t W, class Sample, class Accumulator>
+constexpr void unrolledFoldedStep(Accumulator* sum, Accumulator h, const Sample* x, const Sample* mirror) noexcept {
+    for (size_t w = 0; w < W; ++w) {
+        sum[w] += h * (static_cast <Accumulator> (x[w]) + static_cast <Accumulator> (mirror[w]));
+    }
+}
+
+/// @brief W outputs y[w] = sum of h[j]*x[w+j]
+template <size_t W, class Sample, class Accumulator, size_t N, size_t... J>
+constexpr void unrolledBlock(const Sample* x, const std::array <Accumulator, N>& h, Sample* y, std::index_sequence <J...>) noexcept {
+    Accumulator sum[W] = {};
+    (unrolledStep <W> (sum, h[J], x + J), ...);
+    for (size_t w = 0; w < W; ++w) {
+        y[w] = static_cast <Sample> (sum[w]);
+    }
+}
+
+/// @brief W outputs of a symmetric filter, the mirrored samples are added before the multiply
+template <size_t W, class Sample, class Accumulator, size_t N, size_t... J>
+constexpr void unrolledFoldedBlock(const Sample* x, const std::array <Accumulator, N>& h, Sample* y, std::index_sequence <J...>) noexcept {
+    Accumulator sum[W] = {};
+    (unrolledFoldedStep <W> (sum, h[J], x + J, x + (N - 1 - J)), ...);
+    if constexpr (N % 2 == 1) {
+        unrolledStep <W> (sum, h[N / 2], x + N / 2);
+    }
+    for (size_t w = 0; w < W; ++w) {
+        y[w] = static_cast <Sample> (sum[w]);
+    }
+}
+
+/// @brief W outputs, folded if the filter is symmetric
+template <size_t W, class Sample, class Accumulator, size_t N>
+constexpr void unrolledOutputs(const Sample* x, const std::array <Accumulator, N>& h, bool symmetric, Sample* y) noexcept {
+    if (symmetric) {
+        unrolledFoldedBlock <W> (x, h, y, std::make_index_sequence <N / 2> {});
+    } else {
+        unrolledBlock <W> (x, h, y, std::make_index_sequence <N> {});
+    }
+}
+
+/// @brief the last (fewer than 2*W) outputs, in blocks of halving width
+template <size_t W, class Sample, class Accumulator, size_t N>
+constexpr void unrolledTail(const Sample* x, const std::array <Accumulator, N>& h, bool symmetric, Sample* y, size_t count) noexcept {
+    if (count >= W) {
+        unrolledOutputs <W> (x, h, symmetric, y);
+        x += W;
+        y += W;
+        count -= W;
+    }
+
+    if constexpr (W > 1) {
+        unrolledTail <W / 2> (x, h, symmetric, y, count);
+    }
+}
+
+/// @brief y[n] = sum of h[j]*x[n+j], x is the extended input (N-1 samples of history in front)
+/// @param symmetric true if h is symmetric, the pairs are added before the multiply then
+template <class Sample, class Accumulator, size_t N>
+constexpr void unrolledKernel(const Sample* x, const std::array <Accumulator, N>& h, bool symmetric, Sample* y, size_t count) noexcept {
+    constexpr size_t W = UNROLLED_BLOCK <Accumulator>;
+    size_t n = 0;
+
+    for (; n + W <= count; n += W) {
+        unrolledOutputs <W> (x + n, h, symmetric, y + n);
+    }
+
+    unrolledTail <W / 2> (x + n, h, symmetric, y + n, count - n);
+}
+
+}
+
+///<    compile time designs, the same formulas as WindowLowpass, WindowHighpass and WindowBandpass,
+///<    usable in constant expressions: constexpr auto taps = designLowpass <31> (0.1, wnd::WindowType::Hamming).value();
+
+/// @brief constexpr version of WindowLowpass::create()
+/// @tparam N size of the filter, odd and at least 3
+/// @param fc normalised cutoff frequency, (0, 0.5)
+/// @param w_type type of window
+/// @return taps on success, FIRError on failure
+template <size_t N>
+constexpr std::expected <std::array <double, N>, FIRError> designLowpass(double fc, wnd::WindowType w_type = wnd::WindowType::Rectangular) noexcept {
+    if (fc <= 0 || fc >= 0.5) {
+        return std::unexpected(FIRError::InvalidParameterValue);
+    }
+
+    return detail::designWindowed <N> (w_type, [fc](double x) {
+        return 2.0 * fc * detail::sinc(2.0 * fc * x);
+    });
+}
+
+/// @brief constexpr version of WindowHighpass::create()
+/// @tparam N size of the filter, odd and at least 3
+/// @param fc normalised cutoff frequency, (0, 0.5)
+/// @param w_type type of window
+/// @return taps on success, FIRError on failure
+template <size_t N>
+constexpr std::expected <std::array <double, N>, FIRError> designHighpass(double fc, wnd::WindowType w_type = wnd::WindowType::Rectangular) noexcept {
+    if (fc <= 0 || fc >= 0.5) {
+        return std::unexpected(FIRError::InvalidParameterValue);
+    }
+
+    return detail::designWindowed <N> (w_type, [fc](double x) {
+        return -2.0 * fc * detail::sinc(2.0 * fc * x) + (x == 0.0 ? 1.0 : 0.0);
+    });
+}
+
+/// @brief constexpr version of WindowBandpass::create()
+/// @tparam N size of the filter, odd and at least 3
+/// @param fc_low lower normalised cutoff frequency, (0, 0.5)
+/// @param fc_high higher normalised cutoff frequency, (fc_low, 0.5)
+/// @param w_type type of window
+/// @return taps on success, FIRError on failure
+template <size_t N>
+constexpr std::expected <std::array <double, N>, FIRError> designBandpass(double fc_low, double fc_high,
+                                                                        wnd::WindowType w_type = wnd::WindowType::Rectangular) noexcept {
+    if (fc_low <= 0 || fc_low >= 0.5 || fc_high <= 0 || fc_high >= 0.5) {
+        return std::unexpected(FIRError::InvalidParameterValue);
+    }
+
+    if (fc_low >= fc_high) {
+        return std::unexpected(FIRError::InvalidParameterOrder);
+    }
+
+    return detail::designWindowed <N> (w_type, [fc_low, fc_high](double x) {
+        return 2.0 * fc_high * detail::sinc(2.0 * fc_high * x) - 2.0 * fc_low * detail::sinc(2.0 * fc_low * x);
+    });
+}
+
+template <size_t N, class Sample, class Accumulator>
+class BasicFixedStreamingFIR;
+
+/// @brief a FIR filter whose size is known at compile time, for short fixed filters (e.g. a 31 tap lowpass)
+/// it is a FIR, so it works with convolve(), StreamingFIR, FilterBank and everything else that takes a FIR,
+/// convolveUnrolled() and FixedStreamingFIR use kernels specialised for N with the tap loop fully unrolled,
+/// they are compiled with the flags of the code that uses them (no runtime dispatch): with -O3 and -march of the target
+/// they match the dispatched kernels of convolve() on long signals and are several times faster on short blocks
+/// setWindowType() only records the type, the taps stay as given
+/// @tparam N number of taps
+template <size_t N>
+class FixedFIR : public FIR {
+
+    static_assert(N >= 1 && N <= 255, "FixedFIR is meant for short filters, use FIR for longer ones");
+
+    template <size_t, class, class>
+    friend class BasicFixedStreamingFIR;
+
+    private:
+
+    std::array <double, N> m_taps;
+
+    ///<    reversed taps in both accumulator types, the kernels walk the outputs
+
+    std::array <double, N> m_reversed{};
+
+    std::array <float, N> m_reversed_float{};
+
+    /// @brief constructor, validation must be handled by create()
+    /// @param taps coefficients of the filter
+    FixedFIR(const std::array <double, N>& taps) : FIR(FIRType::Fixed, N), m_taps(taps) {}
+
+    /// @brief reversed taps in the accumulator type
+    template <class Accumulator>
+    const std::array <Accumulator, N>& getReversed() const noexcept {
+        if constexpr (std::is_same_v <Accumulator, double>) {
+            return m_reversed;
+        } else {
+            return m_reversed_float;
+        }
+    }
+
+    protected:
+
+    /// @brief sets the fixed taps as the coefficients
+    /// @return void on success, FIRError on failure
+    std::expected <void, FIRError> calculateCoefficients() override {
+        if (auto w = setCoefficients(std::vector <double> (m_taps.begin(), m_taps.end())); !w) {
+            return std::unexpected(w.error());
+        }
+
+        const std::span <const double> h = getKernelCoefficients();
+        for (size_t j = 0; j < N; ++j) {
+            m_reversed[j] = h[j];
+            m_reversed_float[j] = static_cast <float> (h[j]);
+        }
+
+        return {};
+    }
+
+    public:
+
+    /// @brief number of taps
+    static constexpr size_t SIZE = N;
+
+    /// @brief creates a filter from taps, e.g. from designLowpass()
+    /// @param taps coefficients of the filter
+    /// @return FixedFIR object on success, FIRError on failure
+    static std::expected <FixedFIR, FIRError> create(const std::array <double, N>& taps) {
+        FixedFIR fir(taps);
+
+        if (auto w = fir.calculateCoefficients(); !w) {
+            return std::unexpected(w.error());
+        }
+
+        return fir;
+    }
+
+    /// @brief convolve() with the unrolled kernel, writes the signal.size()+N-1 outputs of the full convolution
+    /// supported pairs: <double, double>, <float, float> and <float, double> (float samples, double coefficients and sums)
+    /// @tparam Sample type of the signal
+    /// @tparam Accumulator type of the coefficients and of the sums
+    /// @param signal input signal
+    /// @param output at least signal.size()+N-1 samples, must not overlap the signal
+    /// @return number of samples written on success, FIRError on failure
+    template <class Sample, class Accumulator = Sample>
+    std::expected <size_t, FIRError> convolveUnrolled(std::span <const std::type_identity_t <Sample>> signal,
+                                                      std::span <std::type_identity_t <Sample>> output) const {
+        static_assert(std::is_same_v <Accumulator, double> || std::is_same_v <Sample, Accumulator>, "unsupported sample and accumulator pair");
+
+        const size_t size = signal.size();
+        const size_t history = N - 1;
+        const size_t total = size + history;
+
+        if (size == 0) {
+            return std::unexpected(FIRError::InvalidSize);
+        }
+
+        if (output.size() < total) {
+            return std::unexpected(FIRError::MismatchedSize);
+        }
+
+        const std::array <Accumulator, N>& h = getReversed <Accumulator> ();
+        const bool symmetric = isSymmetric();
+
+        ///<    outputs history..size-1 read only the signal
+        if (size > history) {
+            detail::unrolledKernel(signal.data(), h, symmetric, output.data() + history, size - history);
+        }
+
+        ///<    the others read zeros before or after the signal, they go through a small zero padded window
+        auto edge = [&](size_t first, size_t last) {
+            for (; first < last; first += std::max <size_t> (history, 1)) {
+                const size_t count = std::min(last - first, std::max <size_t> (history, 1));
+                std::array <Sample, 2 * N> window{};
+                for (size_t i = 0; i < count + history; ++i) {
+                    const size_t k = first + i;
+                    if (k >= history && k - history < size) {
+                        window[i] = signal[k - history];
+                    }
+                }
+                detail::unrolledKernel(window.data(), h, symmetric, output.data() + first, count);
+            }
+        };
+
+        edge(0, std::min(history, total));
+        edge(std::max(history, size), total);
+
+        return total;
+    }
+
+};
+
+/// @brief a stateful processor like BasicStreamingFIR, for a FixedFIR: uses the unrolled kernel and never allocates,
+/// the history and the working buffer are members of the object
+/// supported pairs: <double, double>, <float, float> and <float, double> (float samples, double coefficients and sums)
+/// @tparam N number of taps
+/// @tparam Sample type of the samples
+/// @tparam Accumulator type of the coefficients and of the sums
+template <size_t N, class Sample, class Accumulator = Sample>
+class BasicFixedStreamingFIR {
+
+    static_assert(std::is_same_v <Accumulator, double> || std::is_same_v <Sample, Accumulator>, "unsupported sample and accumulator pair");
+
+    private:
+
+    /// @brief number of input samples processed per pass over the buffer
+    static constexpr size_t CHUNK_SIZE = 256;
+
+    std::array <Accumulator, N> m_reversed_coefficients;
+
+    bool m_symmetric;
+
+    /// @brief working buffer: N-1 samples of history followed by room for one chunk of input
+    std::array <Sample, N - 1 + CHUNK_SIZE> m_buffer{};
+
+    /// @brief constructor, validation must be handled by create()
+    BasicFixedStreamingFIR(const FixedFIR <N>& fir)
+    : m_reversed_coefficients(fir.template getReversed <Accumulator> ()), m_symmetric(fir.isSymmetric()) {}
+
+    public:
+
+    /// @brief creates a streaming processor from a FixedFIR
+    /// @param fir filter to be used
+    /// @return BasicFixedStreamingFIR object on success, FIRError on failure
+    static std::expected <BasicFixedStreamingFIR, FIRError> create(const FixedFIR <N>& fir) {
+        return BasicFixedStreamingFIR(fir);
+    }
+
+    /// @brief filters a block of samples, the history is carried over to the next call
+    /// @param input block of input samples (any size)
+    /// @param output output block, must have the same size as input, may be the same memory as input
+    /// @return void on success, FIRError on failure
+    std::expected <void, FIRError> process(std::span <const Sample> input, std::span <Sample> output) noexcept {
+        if (input.size() != output.size()) {
+            return std::unexpected(FIRError::MismatchedSize);
+        }
+
+        const size_t history = N - 1;
+
+        for (size_t offset = 0; offset < input.size(); offset += CHUNK_SIZE) {
+            const size_t count = std::min(CHUNK_SIZE, input.size() - offset);
+            std::copy(input.begin() + offset, input.begin() + offset + count, m_buffer.begin() + history);
+            detail::unrolledKernel(m_buffer.data(), m_reversed_coefficients, m_symmetric, output.data() + offset, count);
+            std::copy(m_buffer.begin() + count, m_buffer.begin() + count + history, m_buffer.begin());
+        }
+
+        return {};
+    }
+
+    /// @brief filters a block of samples, overriding it with the result
+    /// @param signal block of samples (any size)
+    /// @return void on success, FIRError on failure
+    std::expected <void, FIRError> processInPlace(std::span <Sample> signal) noexcept {
+        return process(signal, signal);
+    }
+
+    /// @brief clears the history, as if no samples were processed yet
+    void reset() noexcept {
+        m_buffer.fill(Sample(0));
+    }
+
+    /// @brief getter for size
+    /// @return size of the filter
+    static constexpr size_t getSize() noexcept {
+        return N;
+    }
+
+};
+
+/// @brief fixed size streaming processor for double samples
+template <size_t N>
+using FixedStreamingFIR = BasicFixedStreamingFIR <N, double>;
+
+/// @brief fixed size streaming processor for float samples, float coefficients and sums
+template <size_t N>
+using FixedStreamingFIRFloat = BasicFixedStreamingFIR <N, float>;
+
+/// @brief fixed size streaming processor for float samples, double coefficients and sums
+template <size_t N>
+using FixedStreamingFIRMixed = BasicFixedStreamingFIR <N, float, double>;
+
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "FIR.hpp"
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <limits>
+#include <type_traits>
+
+namespace oh::fir {
+
+/// @brief fixed-point version of a FIR filter, for int16 (Q15) or int32 (Q31) signals
+/// the coefficients are quantised once from FIR::getCoefficients() and saturated to the symmetric range [-max, max]
+/// every output is the exact sum of the products, rounded to the nearest value and saturated, so any gain saturates
+/// instead of wrapping around and results are bit-exact on every instruction set
+/// (Q31 products are summed as two 64 bit sums of the halves of the coefficients, which limits Q31 filters to MAX_SIZE taps)
+/// @tparam Sample int16_t (Q15) or int32_t (Q31)
+template <class Sample>
+class BasicFixedPointFIR {
+
+    private:
+
+    /// @brief quantised coefficients, in the original order
+    std::vector <Sample> m_coefficients;
+
+    /// @brief quantised coefficients in reversed order, used by the kernels
+    std::vector <Sample> m_reversed_coefficients;
+
+    /// @brief largest absolute difference between a coefficient and its quantised value
+    double m_quantisation_error;
+
+    /// @brief constructor, validation must be handled by create()
+    /// @param coefficients coefficients to be quantised
+    BasicFixedPointFIR(const std::vector <double>& coefficients);
+
+    public:
+
+    /// @brief number of fractional bits, 15 for Q15 and 31 for Q31
+    static constexpr int FRACTIONAL_BITS = std::numeric_limits <Sample>::digits;
+
+    /// @brief largest number of taps whose sums cannot overflow
+    static constexpr size_t MAX_SIZE = std::is_same_v <Sample, int32_t> ? 65535 : std::numeric_limits <uint32_t>::max();
+
+    /// @brief quantises the coefficients of any FIR filter
+    /// @param fir filter to be used
+    /// @return BasicFixedPointFIR object on success, FIRError on failure (InvalidSize above MAX_SIZE taps)
+    static std::expected <BasicFixedPointFIR, FIRError> create(const FIR& fir);
+
+    /// @brief converts a value to the fixed-point format, rounded and saturated to [-max, max]
+    /// @param value value to be converted
+    /// @return fixed-point value
+    static Sample quantise(double value) noexcept;
+
+    /// @brief calulates the convolution of signal with the filter
+    /// @param signal input signal
+    /// @return vector containing convluted signal(copy), size+getSize()-1 samples
+    std::expected <std::vector <Sample>, FIRError> convolve(const std::vector <Sample>& signal) const;
+
+    /// @brief calulates the convolution of signal with the filter into a caller provided buffer, nothing is allocated
+    /// @param signal input signal
+    /// @param output at least signal.size()+getSize()-1 samples, must not overlap the signal
+    /// @return number of samples written on success, FIRError on failure
+    std::expected <size_t, FIRError> convolve(std::span <const Sample> signal, std::span <Sample> output) const;
+
+    /// @brief getter for coefficients
+    /// @return quantised coefficients
+    const std::vector <Sample>& getCoefficients() const noexcept;
+
+    /// @brief getter for quantisation error
+    /// @return largest absolute difference between a coefficient and its quantised value (as a fraction of full scale)
+    double getQuantisationError() const noexcept;
+
+    /// @brief getter for size
+    /// @return size of the filter
+    size_t getSize() const noexcept;
+
+};
+
+extern template class BasicFixedPointFIR <int16_t>;
+extern template class BasicFixedPointFIR <int32_t>;
+
+/// @brief Q15 filter: int16 samples and coefficients
+using Q15FIR = BasicFixedPointFIR <int16_t>;
+
+/// @brief Q31 filter: int32 samples and coefficients
+using Q31FIR = BasicFixedPointFIR <int32_t>;
+
+}
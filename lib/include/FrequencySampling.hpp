@@ -39,6 +39,10 @@ class FrequencySampling : public FIR{
     /// @return m_half_frequency_spectrum
     std::vector <double> getFrequencyHalfSpectrum();
 
+    /// @brief design parameters
+    /// @return the half frequency spectrum
+    std::vector <double> getDesignParameters() const override;
+
 };
 
 
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#ifdef EASYDSP_INSTRUMENTATION
+#include <atomic>
+#include <chrono>
+#endif
+
+namespace oh::fir {
+
+///<    opt-in counters of the hot paths: configure with -DEASYDSP_INSTRUMENTATION=ON (cmake option), which defines
+///<    EASYDSP_INSTRUMENTATION for the library and everything linking it, without it the counters are empty types
+///<    the compiler removes completely and getStats() returns zeros
+///<    the library never replaces the global allocation functions, programs that want allocations counted link the
+///<    easydsp_count_allocations object library, which does (and so cannot be combined with another replacement)
+
+#ifdef EASYDSP_INSTRUMENTATION
+inline constexpr bool INSTRUMENTATION_ENABLED = true;
+#else
+inline constexpr bool INSTRUMENTATION_ENABLED = false;
+#endif
+
+/// @brief snapshot of the counters of one filter (or processor) since its creation or its last resetStats()
+struct FilterStats {
+    uint64_t calls = 0;                     ///<    calls of the instrumented methods (convolve, process...)
+    uint64_t samples = 0;                   ///<    input samples of all calls
+    uint64_t macs = 0;                      ///<    multiply-adds of the direct form, the fft paths do fewer
+    uint64_t total_ns = 0;                  ///<    time spent in all calls
+    uint64_t max_ns = 0;                    ///<    longest call
+    uint64_t allocations = 0;               ///<    heap allocations made during the calls on the calling thread,
+                                            ///<    counted only if the program links easydsp_count_allocations
+};
+
+namespace detail {
+
+///<    allocation counts exist in every build, they stay 0 unless the program links easydsp_count_allocations
+
+/// @brief number of heap allocations made by this thread, counted by the global operator new of the
+/// easydsp_count_allocations object library, always 0 if the program does not link it
+/// @return count
+uint64_t getThreadAllocationCount() noexcept;
+
+/// @brief number of heap allocations made by all threads since the start of the program, counted like
+/// getThreadAllocationCount()
+/// @return count
+uint64_t getAllocationCount() noexcept;
+
+/// @brief counts one heap allocation of this thread, called by the operator new of easydsp_count_allocations
+void countAllocation() noexcept;
+
+#ifdef EASYDSP_INSTRUMENTATION
+
+/// @brief relaxed atomic counters, a filter used from several threads at once stays consistent
+/// copies take the values of the source, so a moved filter keeps its history
+class Counters {
+
+    private:
+
+    std::atomic <uint64_t> m_calls{0};
+    std::atomic <uint64_t> m_samples{0};
+    std::atomic <uint64_t> m_macs{0};
+    std::atomic <uint64_t> m_total_ns{0};
+    std::atomic <uint64_t> m_max_ns{0};
+    std::atomic <uint64_t> m_allocations{0};
+
+    void assign(const FilterStats& stats) noexcept;
+
+    public:
+
+    Counters() = default;
+    Counters(const Counters& other) noexcept;
+    Counters& operator=(const Counters& other) noexcept;
+
+    /// @brief adds one call
+    void record(uint64_t samples, uint64_t macs, uint64_t ns, uint64_t allocations) noexcept;
+
+    FilterStats snapshot() const noexcept;
+
+    void reset() noexcept;
+
+};
+
+/// @brief measures the scope it lives in and records it as one call when it ends
+class ScopedMeasurement {
+
+    private:
+
+    Counters& m_counters;
+
+    uint64_t m_samples;
+
+    uint64_t m_macs;
+
+    uint64_t m_allocations;
+
+    std::chrono::steady_clock::time_point m_start;
+
+    public:
+
+    ScopedMeasurement(Counters& counters, uint64_t samples, uint64_t macs) noexcept
+    : m_counters(counters), m_samples(samples), m_macs(macs), m_allocations(getThreadAllocationCount()),
+      m_start(std::chrono::steady_clock::now()) {}
+
+    ScopedMeasurement(const ScopedMeasurement&) = delete;
+    ScopedMeasurement& operator=(const ScopedMeasurement&) = delete;
+
+    ~ScopedMeasurement() {
+        const auto ns = std::chrono::duration_cast <std::chrono::nanoseconds> (std::chrono::steady_clock::now() - m_start).count();
+        m_counters.record(m_samples, m_macs, static_cast <uint64_t> (ns), getThreadAllocationCount() - m_allocations);
+    }
+
+};
+
+#else
+
+/// @brief empty counters of a build without instrumentation
+class Counters {
+
+    public:
+
+    FilterStats snapshot() const noexcept {
+        return {};
+    }
+
+    void reset() noexcept {}
+
+};
+
+/// @brief does nothing in a build without instrumentation
+class ScopedMeasurement {
+
+    public:
+
+    constexpr ScopedMeasurement(Counters&, uint64_t, uint64_t) noexcept {}
+
+};
+
+#endif
+
+}
+
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "FIR.hpp"
+
+#include <vector>
+#include <cstddef>
+#include <expected>
+#include <span>
+
+namespace oh::fir {
+
+/// @brief a stateful polyphase interpolator: raises the sample rate by factor and filters out the images
+/// the result equals inserting factor-1 zeros after every sample and filtering, but the zeros are never multiplied:
+/// the coefficients are split into factor sub-filters, sub-filter q calculates the outputs m*factor+q directly from
+/// the input, so one output costs size/factor multiplies
+/// supported pairs: <double, double>, <float, float> and <float, double> (float samples, double coefficients and sums)
+/// @tparam Sample type of the samples
+/// @tparam Accumulator type of the coefficients and of the sums
+template <class Sample, class Accumulator = Sample>
+class BasicInterpolator {
+
+    private:
+
+    size_t m_factor;
+
+    size_t m_size;
+
+    /// @brief number of coefficients of every sub-filter
+    size_t m_phase_length;
+
+    /// @brief sub-filters (coefficients h[i*factor+q], reversed, multiplied by the gain), one after another
+    std::vector <Accumulator> m_phases;
+
+    /// @brief working buffer: m_phase_length-1 samples of history followed by room for one chunk of input
+    std::vector <Sample> m_buffer;
+
+    /// @brief outputs of one sub-filter for a chunk
+    std::vector <Sample> m_phase_output;
+
+    /// @brief number of input samples per pass over the buffer
+    size_t m_chunk_size;
+
+    /// @brief constructor, validation must be handled by create()
+    /// @param coefficients coefficients of the filter
+    /// @param factor interpolation factor
+    /// @param gain factor the coefficients are multiplied by
+    BasicInterpolator(const std::vector <double>& coefficients, size_t factor, double gain);
+
+    /// @brief filters the chunk in the buffer and writes its count*factor outputs
+    /// @param output pointer to the outputs
+    /// @param count number of new input samples in the buffer
+    void processChunk(Sample* output, size_t count) noexcept;
+
+    public:
+
+    /// @brief creates an interpolator with gain compensation: the coefficients are multiplied by factor,
+    /// which restores the level lost by the inserted zeros
+    /// @param fir anti-imaging filter, its gain above 0.5/factor must be at least 3 dB below its peak
+    /// @param factor interpolation factor, nonzero
+    /// @return BasicInterpolator object on success, FIRError on failure
+    static std::expected <BasicInterpolator, FIRError> create(const FIR& fir, size_t factor);
+
+    /// @brief creates an interpolator with a chosen gain, 1.0 gives exactly the zero-stuffed convolution
+    /// @param fir anti-imaging filter, its gain above 0.5/factor must be at least 3 dB below its peak
+    /// @param factor interpolation factor, nonzero
+    /// @param gain factor the coefficients are multiplied by, nonzero
+    /// @return BasicInterpolator object on success, FIRError on failure
+    static std::expected <BasicInterpolator, FIRError> create(const FIR& fir, size_t factor, double gain);
+
+    /// @brief interpolates a block of samples (any size), the history is carried over to the next call
+    /// @param input block of input samples
+    /// @param output at least input.size()*getFactor() samples, must not overlap the input
+    /// @return number of outputs written on success, FIRError on failure
+    std::expected <size_t, FIRError> process(std::span <const Sample> input, std::span <Sample> output);
+
+    /// @brief interpolates a block of samples (any size), the history is carried over to the next call
+    /// @param input block of input samples
+    /// @return vector of input.size()*getFactor() outputs on success, FIRError on failure
+    std::expected <std::vector <Sample>, FIRError> process(const std::vector <Sample>& input);
+
+    /// @brief clears the history, as if no samples were processed yet
+    void reset() noexcept;
+
+    /// @brief getter for factor
+    /// @return interpolation factor
+    size_t getFactor() const noexcept;
+
+    /// @brief getter for size
+    /// @return size of the filter
+    size_t getSize() const noexcept;
+
+};
+
+extern template class BasicInterpolator <double, double>;
+extern template class BasicInterpolator <float, float>;
+extern template class BasicInterpolator <float, double>;
+
+/// @brief interpolator for double samples
+using Interpolator = BasicInterpolator <double>;
+
+/// @brief interpolator for float samples, float coefficients and sums
+using InterpolatorFloat = BasicInterpolator <float>;
+
+/// @brief interpolator for float samples, double coefficients and sums
+using InterpolatorMixed = BasicInterpolator <float, double>;
+
+}
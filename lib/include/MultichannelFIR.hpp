@@ -0,0 +1,111 @@
+#pragma once
+
+#include "FIR.hpp"
+
+#include <vector>
+#include <cstddef>
+#include <expected>
+#include <span>
+#include <string>
+
+namespace oh::fir {
+
+/// @brief enum used to describe how the samples of several channels are stored in one buffer
+enum class ChannelLayout {
+    Planar,         ///< channel-major: all samples of channel 0, then all samples of channel 1, ...
+    Interleaved     ///< sample-major: sample 0 of every channel, then sample 1 of every channel, ...
+};
+
+/// @brief used to translate ChannelLayout to std::string
+/// @param layout
+/// @return string
+std::string toString(ChannelLayout layout);
+
+/// @brief filters many synchronised channels with the same filter
+/// the work is done on interleaved frames, so the simd lanes span channels and every coefficient is loaded once
+/// for a whole group of channels, interleaved buffers are used as they are, planar ones are interleaved chunk by chunk
+/// supported pairs: <double, double>, <float, float> and <float, double> (float samples, double coefficients and sums)
+/// @tparam Sample type of the samples
+/// @tparam Accumulator type of the coefficients and of the sums
+template <class Sample, class Accumulator = Sample>
+class BasicMultichannelFIR {
+
+    private:
+
+    /// @brief coefficients stored in reversed order
+    std::vector <Accumulator> m_reversed_coefficients;
+
+    bool m_symmetric;
+
+    size_t m_channels;
+
+    /// @brief number of frames processed per pass over the buffer
+    size_t m_chunk_frames;
+
+    /// @brief interleaved working buffer: size-1 frames of history followed by room for one chunk
+    std::vector <Sample> m_buffer;
+
+    /// @brief interleaved outputs of one chunk, only used for planar buffers, allocated with the object so process() never allocates
+    std::vector <Sample> m_output;
+
+    /// @brief constructor, validation must be handled by create()
+    /// @param fir filter whose coefficients are copied
+    /// @param channels number of channels
+    BasicMultichannelFIR(const FIR& fir, size_t channels);
+
+    public:
+
+    /// @brief creates a multichannel processor from any FIR filter (coefficients are copied in the Accumulator type)
+    /// @param fir filter to be used
+    /// @param channels number of channels, nonzero
+    /// @return BasicMultichannelFIR object on success, FIRError on failure
+    static std::expected <BasicMultichannelFIR, FIRError> create(const FIR& fir, size_t channels);
+
+    /// @brief filters a block of frames of every channel, the history of each channel is carried over to the next call
+    /// @param input channels*frames samples in the given layout (any number of frames)
+    /// @param output output block, must have the same size as input, may be the same memory as input
+    /// @param layout layout of both input and output
+    /// @return void on success, FIRError on failure
+    std::expected <void, FIRError> process(std::span <const Sample> input, std::span <Sample> output, ChannelLayout layout);
+
+    /// @brief filters a block of frames of every channel, overriding it with the result
+    /// @param signal channels*frames samples in the given layout
+    /// @param layout layout of the signal
+    /// @return void on success, FIRError on failure
+    std::expected <void, FIRError> processInPlace(std::span <Sample> signal, ChannelLayout layout);
+
+    /// @brief calulates the full convolution of every channel, independent of the streaming history
+    /// the signal is run through in chunks, the scratch memory is about (getSize()+chunk)*channels samples, whatever the signal length
+    /// @param input channels*frames samples in the given layout
+    /// @param output channels*(frames+getSize()-1) samples, written in the same layout, must not overlap the input
+    /// @param layout layout of both input and output
+    /// @return number of samples written on success, FIRError on failure
+    std::expected <size_t, FIRError> convolve(std::span <const Sample> input, std::span <Sample> output, ChannelLayout layout) const;
+
+    /// @brief clears the history of every channel, as if no samples were processed yet
+    void reset() noexcept;
+
+    /// @brief getter for channels
+    /// @return number of channels
+    size_t getChannels() const noexcept;
+
+    /// @brief getter for size
+    /// @return size of the filter
+    size_t getSize() const noexcept;
+
+};
+
+extern template class BasicMultichannelFIR <double, double>;
+extern template class BasicMultichannelFIR <float, float>;
+extern template class BasicMultichannelFIR <float, double>;
+
+/// @brief multichannel processor for double samples
+using MultichannelFIR = BasicMultichannelFIR <double>;
+
+/// @brief multichannel processor for float samples, float coefficients and sums
+using MultichannelFIRFloat = BasicMultichannelFIR <float>;
+
+/// @brief multichannel processor for float samples, double coefficients and sums
+using MultichannelFIRMixed = BasicMultichannelFIR <float, double>;
+
+}
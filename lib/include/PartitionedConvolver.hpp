@@ -0,0 +1,136 @@
+#pragma once
+
+#include "FIR.hpp"
+
+#include <vector>
+#include <cstddef>
+#include <expected>
+#include <span>
+
+namespace oh::fir {
+
+namespace detail {
+class UniformPartition;
+}
+
+/// @brief a low latency fft convolver for long filters
+/// the coefficients are split into frequency-domain partitions, the output is delayed by exactly block_size samples
+/// (the latency), independent of the filter length
+class PartitionedConvolver {
+
+    private:
+
+    size_t m_size;
+
+    size_t m_block_size;
+
+    /// @brief stages with growing block sizes, all aligned to the latency of the first one
+    std::vector <detail::UniformPartition> m_stages;
+
+    /// @brief input samples of the block being filled
+    std::vector <double> m_input;
+
+    /// @brief outputs of the last full block, handed out while the next one is filled
+    std::vector <double> m_output;
+
+    size_t m_fill;
+
+    /// @brief hot path counters, an empty type unless built with EASYDSP_INSTRUMENTATION
+    [[no_unique_address]] detail::Counters m_counters;
+
+    /// @brief constructor, validation must be handled by create()
+    /// @param coefficients coefficients of the filter
+    /// @param block_size size of the first (smallest) partition
+    /// @param max_block_size size of the largest partition
+    PartitionedConvolver(const std::vector <double>& coefficients, size_t block_size, size_t max_block_size);
+
+    /// @brief runs every stage on the full input block
+    void processBlock() noexcept;
+
+    /// @brief shared implementation of the process overloads, samples are converted while copied into the block
+    template <class Sample>
+    std::expected <void, FIRError> processSamples(std::span <const Sample> input, std::span <Sample> output);
+
+    public:
+
+    PartitionedConvolver(const PartitionedConvolver& other);
+    PartitionedConvolver(PartitionedConvolver&& other) noexcept;
+    PartitionedConvolver& operator=(const PartitionedConvolver& other);
+    PartitionedConvolver& operator=(PartitionedConvolver&& other) noexcept;
+    ~PartitionedConvolver();
+
+    /// @brief creates a uniformly partitioned convolver
+    /// @param fir filter to be used
+    /// @param block_size block size and latency, power of two, at least 8
+    /// @return PartitionedConvolver on success, FIRError on failure
+    static std::expected <PartitionedConvolver, FIRError> create(const FIR& fir, size_t block_size);
+
+    /// @brief creates a non-uniformly partitioned convolver
+    /// the first partitions have block_size, later ones double in size up to max_block_size,
+    /// which keeps the latency at block_size with fewer partitions for the tail of the filter
+    /// @param fir filter to be used
+    /// @param block_size size of the first partitions and latency, power of two, at least 8
+    /// @param max_block_size size of the largest partitions, power of two, not lower than block_size
+    /// @return PartitionedConvolver on success, FIRError on failure
+    static std::expected <PartitionedConvolver, FIRError> create(const FIR& fir, size_t block_size, size_t max_block_size);
+
+    /// @brief filters a block of samples (any size), the output is delayed by getLatency() samples
+    /// @param input block of input samples
+    /// @param output output block, must have the same size as input
+    /// @return void on success, FIRError on failure
+    std::expected <void, FIRError> process(const std::vector <double>& input, std::vector <double>& output);
+
+    /// @brief filters a block of samples, overriding it with the result
+    /// @param signal block of samples
+    /// @return void on success, FIRError on failure
+    std::expected <void, FIRError> processInPlace(std::vector <double>& signal);
+
+    /// @brief filters a block of float samples (any size), the spectra are still calculated in double
+    /// @param input block of input samples
+    /// @param output output block, must have the same size as input
+    /// @return void on success, FIRError on failure
+    std::expected <void, FIRError> process(const std::vector <float>& input, std::vector <float>& output);
+
+    /// @brief filters a block of float samples, overriding it with the result
+    /// @param signal block of samples
+    /// @return void on success, FIRError on failure
+    std::expected <void, FIRError> processInPlace(std::vector <float>& signal);
+
+    /// @brief filters a block of samples held in memory owned by the caller, nothing is allocated
+    /// @param input block of input samples
+    /// @param output output block, must have the same size as input, may be the same memory as input
+    /// @return void on success, FIRError on failure
+    std::expected <void, FIRError> process(std::span <const double> input, std::span <double> output);
+
+    /// @brief float version of the caller owned memory process()
+    std::expected <void, FIRError> process(std::span <const float> input, std::span <float> output);
+
+    /// @brief clears all state, as if no samples were processed yet
+    void reset() noexcept;
+
+    /// @brief counters of the process() calls
+    /// @return snapshot of the counters, all zero unless the library is built with EASYDSP_INSTRUMENTATION
+    FilterStats getStats() const noexcept;
+
+    /// @brief sets the counters to zero
+    void resetStats() noexcept;
+
+    /// @brief getter for latency
+    /// @return delay of the output in samples
+    size_t getLatency() const noexcept;
+
+    /// @brief getter for block size
+    /// @return size of the smallest partition
+    size_t getBlockSize() const noexcept;
+
+    /// @brief getter for size
+    /// @return size of the filter
+    size_t getSize() const noexcept;
+
+    /// @brief getter for number of partitions
+    /// @return number of partitions in all stages
+    size_t getPartitionCount() const noexcept;
+
+};
+
+}
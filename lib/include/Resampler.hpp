@@ -0,0 +1,129 @@
+#pragma once
+
+#include "FIR.hpp"
+
+#include <vector>
+#include <cstddef>
+#include <expected>
+#include <span>
+
+namespace oh::fir {
+
+/// @brief a stateful rational resampler: changes the sample rate by up/down (e.g. 160/147 for 44.1k to 48k)
+/// works like interpolating by up, filtering and decimating by down, but only calculates the outputs that are kept
+/// and never multiplies the inserted zeros: every output uses one of up sub-filters, size/up multiplies per output
+/// the filter can be designed automatically with WindowLowpass from a transition width
+/// supported pairs: <double, double>, <float, float> and <float, double> (float samples, double coefficients and sums)
+/// @tparam Sample type of the samples
+/// @tparam Accumulator type of the coefficients and of the sums
+template <class Sample, class Accumulator = Sample>
+class BasicResampler {
+
+    private:
+
+    /// @brief interpolation factor (after dividing up and down by their gcd)
+    size_t m_up;
+
+    /// @brief decimation factor (after dividing up and down by their gcd)
+    size_t m_down;
+
+    size_t m_size;
+
+    /// @brief number of coefficients of every sub-filter
+    size_t m_phase_length;
+
+    /// @brief sub-filters (coefficients h[i*up+q] multiplied by up, reversed), one after another
+    std::vector <Accumulator> m_phases;
+
+    /// @brief working buffer: m_phase_length-1 samples of history followed by room for one chunk of input
+    std::vector <Sample> m_buffer;
+
+    /// @brief number of input samples per pass over the buffer
+    size_t m_chunk_size;
+
+    /// @brief position of the next output on the interpolated time axis (up per input sample),
+    /// counted from the first input sample of the next chunk
+    size_t m_position;
+
+    /// @brief constructor, validation must be handled by create()
+    /// @param coefficients coefficients of the filter
+    /// @param up interpolation factor
+    /// @param down decimation factor
+    BasicResampler(const std::vector <double>& coefficients, size_t up, size_t down);
+
+    /// @brief resamples the chunk in the buffer and writes its outputs
+    /// @param output pointer to the outputs
+    /// @param count number of new input samples in the buffer
+    /// @return number of outputs written
+    size_t processChunk(Sample* output, size_t count) noexcept;
+
+    public:
+
+    /// @brief creates a resampler with a WindowLowpass designed for the given transition width
+    /// the stopband starts at the lower of the two nyquist frequencies, the passband ends transition below it
+    /// @param up interpolation factor, nonzero
+    /// @param down decimation factor, nonzero
+    /// @param transition width of the transition band, normalised to the lower of the two sample rates, (0, 0.5)
+    /// @param w_type window used for the design, sets the stopband attenuation (Blackman by default)
+    /// @return BasicResampler object on success, FIRError on failure
+    static std::expected <BasicResampler, FIRError> create(size_t up, size_t down, double transition,
+                                                           wnd::WindowType w_type = wnd::WindowType::Blackman);
+
+    /// @brief creates a resampler with a given filter, designed for the interpolated rate (up times the input rate)
+    /// @param fir anti-imaging and anti-alias filter, its gain above 0.5/max(up, down) must be at least 3 dB below its peak
+    /// @param up interpolation factor, nonzero
+    /// @param down decimation factor, nonzero
+    /// @return BasicResampler object on success, FIRError on failure
+    static std::expected <BasicResampler, FIRError> create(const FIR& fir, size_t up, size_t down);
+
+    /// @brief number of outputs the next process() call produces for a given number of input samples
+    /// @param input_size number of input samples
+    /// @return number of outputs
+    size_t getOutputSize(size_t input_size) const noexcept;
+
+    /// @brief resamples a block of samples (any size), the state is carried over to the next call
+    /// @param input block of input samples
+    /// @param output at least getOutputSize(input.size()) samples, must not overlap the input
+    /// @return number of outputs written on success, FIRError on failure
+    std::expected <size_t, FIRError> process(std::span <const Sample> input, std::span <Sample> output);
+
+    /// @brief resamples a block of samples (any size), the state is carried over to the next call
+    /// @param input block of input samples
+    /// @return vector of getOutputSize(input.size()) outputs on success, FIRError on failure
+    std::expected <std::vector <Sample>, FIRError> process(const std::vector <Sample>& input);
+
+    /// @brief clears the history, as if no samples were processed yet
+    void reset() noexcept;
+
+    /// @brief getter for group delay
+    /// @return delay of the (linear phase) filter in output samples
+    double getGroupDelay() const noexcept;
+
+    /// @brief getter for up factor
+    /// @return interpolation factor, reduced by the gcd of up and down
+    size_t getUpFactor() const noexcept;
+
+    /// @brief getter for down factor
+    /// @return decimation factor, reduced by the gcd of up and down
+    size_t getDownFactor() const noexcept;
+
+    /// @brief getter for size
+    /// @return size of the filter
+    size_t getSize() const noexcept;
+
+};
+
+extern template class BasicResampler <double, double>;
+extern template class BasicResampler <float, float>;
+extern template class BasicResampler <float, double>;
+
+/// @brief resampler for double samples
+using Resampler = BasicResampler <double>;
+
+/// @brief resampler for float samples, float coefficients and sums
+using ResamplerFloat = BasicResampler <float>;
+
+/// @brief resampler for float samples, double coefficients and sums
+using ResamplerMixed = BasicResampler <float, double>;
+
+}
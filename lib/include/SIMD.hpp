@@ -0,0 +1,36 @@
+#pragma once
+
+#include "FIR.hpp"
+
+#include <expected>
+#include <string>
+
+namespace oh::fir {
+
+/// @brief enum used to represent the instruction set used by the convolution kernels
+enum class SIMDLevel {
+    Scalar,
+    SSE2,
+    AVX2,
+    AVX512
+};
+
+/// @brief used to translate SIMDLevel to std::string
+/// @param level
+/// @return string
+std::string toString(SIMDLevel level);
+
+/// @brief best instruction set supported by this cpu (checked with cpuid on first use)
+/// @return SIMDLevel
+SIMDLevel getSupportedSIMDLevel() noexcept;
+
+/// @brief instruction set currently used by the kernels, by default the best supported one
+/// @return SIMDLevel
+SIMDLevel getSIMDLevel() noexcept;
+
+/// @brief forces the kernels to use a specific instruction set (for testing and comparing), affects all filters
+/// @param level instruction set to be used
+/// @return void on success, FIRError::InvalidParameterValue if the cpu does not support it
+std::expected <void, FIRError> setSIMDLevel(SIMDLevel level);
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace oh::fir {
+
+/// @brief enum used to describe how samples are stored in a file (little endian, as in wav files)
+/// integers are scaled to [-1, 1) when read, rounded and saturated when written
+enum class SampleFormat {
+    Int16,          ///< signed 16 bit integers, full scale is 2^15
+    Int24,          ///< signed 24 bit integers packed in 3 bytes, full scale is 2^23
+    Int32,          ///< signed 32 bit integers, full scale is 2^31
+    Float32,
+    Float64
+};
+
+/// @brief used to translate SampleFormat to std::string
+/// @param format
+/// @return string
+std::string toString(SampleFormat format);
+
+/// @brief size of one sample
+/// @param format
+/// @return bytes per sample
+size_t getSampleSize(SampleFormat format) noexcept;
+
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "FIR.hpp"
+
+#include <vector>
+#include <cstddef>
+#include <expected>
+#include <span>
+#include <memory>
+#include <type_traits>
+
+namespace oh::fir {
+
+namespace detail {
+class OverlapSave;
+}
+
+/// @brief a stateful processor that filters a continuous signal block by block
+/// keeps the last size-1 input samples between calls, so every input sample produces exactly one output sample
+/// supported pairs: <double, double>, <float, float> and <float, double> (float samples, double coefficients and sums)
+/// @tparam Sample type of the samples
+/// @tparam Accumulator type of the coefficients and of the sums
+template <class Sample, class Accumulator = Sample>
+class BasicStreamingFIR {
+
+    private:
+
+    /// @brief float sums have twice the simd lanes, which moves the point where the fft pays off
+    static constexpr bool SINGLE_PRECISION = std::is_same_v <Accumulator, float>;
+
+    /// @brief coefficients stored in reversed order, so the inner loop walks input and taps forward
+    std::vector <Accumulator> m_reversed_coefficients;
+
+    /// @brief working buffer: size-1 samples of history followed by room for one chunk of input
+    std::vector <Sample> m_buffer;
+
+    /// @brief true if the coefficients are symmetric, the folded kernels are used then
+    bool m_symmetric;
+
+    /// @brief number of input samples processed per pass over the buffer
+    size_t m_chunk_size;
+
+    /// @brief overlap-save engine, only created for filters long enough to benefit from it
+    std::unique_ptr <detail::OverlapSave> m_fft_engine;
+
+    /// @brief hot path counters, an empty type unless built with EASYDSP_INSTRUMENTATION
+    [[no_unique_address]] detail::Counters m_counters;
+
+    /// @brief constructor, validation must be handled by create()
+    /// @param fir filter whose coefficients are copied
+    BasicStreamingFIR(const FIR& fir);
+
+    /// @brief filters one chunk that has already been copied into the buffer, then shifts the history
+    /// @param output pointer to at least count output samples
+    /// @param count number of samples in the chunk
+    void processChunk(Sample* output, size_t count) noexcept;
+
+    public:
+
+    BasicStreamingFIR(const BasicStreamingFIR& other);
+    BasicStreamingFIR(BasicStreamingFIR&& other) noexcept;
+    BasicStreamingFIR& operator=(const BasicStreamingFIR& other);
+    BasicStreamingFIR& operator=(BasicStreamingFIR&& other) noexcept;
+    ~BasicStreamingFIR();
+
+    /// @brief creates a streaming processor from any FIR filter (coefficients are copied in the Accumulator type)
+    /// @param fir filter to be used
+    /// @return BasicStreamingFIR object on success, FIRError on failure
+    static std::expected <BasicStreamingFIR, FIRError> create(const FIR& fir);
+
+    /// @brief filters a block of samples, the history is carried over to the next call
+    /// @param input block of input samples (any size)
+    /// @param output output block, must have the same size as input
+    /// @return void on success, FIRError on failure
+    std::expected <void, FIRError> process(const std::vector <Sample>& input, std::vector <Sample>& output);
+
+    /// @brief filters a block of samples, overriding it with the result
+    /// @param signal block of samples (any size)
+    /// @return void on success, FIRError on failure
+    std::expected <void, FIRError> processInPlace(std::vector <Sample>& signal);
+
+    /// @brief filters a block of samples held in memory owned by the caller, nothing is allocated
+    /// @param input block of input samples (any size)
+    /// @param output output block, must have the same size as input, may be the same memory as input
+    /// @return void on success, FIRError on failure
+    std::expected <void, FIRError> process(std::span <const Sample> input, std::span <Sample> output);
+
+    /// @brief filters a block of samples held in memory owned by the caller, overriding it with the result
+    /// @param signal block of samples (any size)
+    /// @return void on success, FIRError on failure
+    std::expected <void, FIRError> processInPlace(std::span <Sample> signal);
+
+    /// @brief clears the history, as if no samples were processed yet
+    void reset() noexcept;
+
+    /// @brief getter for size
+    /// @return size of the filter
+    size_t getSize() const noexcept;
+
+    /// @brief counters of the process() calls
+    /// @return snapshot of the counters, all zero unless the library is built with EASYDSP_INSTRUMENTATION
+    FilterStats getStats() const noexcept;
+
+    /// @brief sets the counters to zero
+    void resetStats() noexcept;
+
+    /// @brief tells which method is used for full chunks
+    /// @return ConvolutionMethod::FFT if the overlap-save engine is used, ConvolutionMethod::Direct otherwise
+    ConvolutionMethod getMethod() const noexcept;
+
+};
+
+extern template class BasicStreamingFIR <double, double>;
+extern template class BasicStreamingFIR <float, float>;
+extern template class BasicStreamingFIR <float, double>;
+
+/// @brief streaming processor for double samples
+using StreamingFIR = BasicStreamingFIR <double>;
+
+/// @brief streaming processor for float samples, float coefficients and sums
+using StreamingFIRFloat = BasicStreamingFIR <float>;
+
+/// @brief streaming processor for float samples, double coefficients and sums
+using StreamingFIRMixed = BasicStreamingFIR <float, double>;
+
+}
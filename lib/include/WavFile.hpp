@@ -0,0 +1,163 @@
+#pragma once
+
+#include "FIR.hpp"
+#include "SampleFormat.hpp"
+
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace oh::fir {
+
+namespace detail {
+
+/// @brief deleter of the file handles of the readers and writers
+struct FileCloser {
+    void operator()(std::FILE* file) const noexcept {
+        std::fclose(file);
+    }
+};
+
+}
+
+/// @brief layout of the samples of a wav file
+struct WavFormat {
+    uint32_t sample_rate = 48000;
+    uint16_t channels = 1;
+    SampleFormat sample_format = SampleFormat::Int16;       ///<    pcm Int16, Int24, Int32 or ieee Float32, Float64
+};
+
+/// @brief streaming reader of pcm and ieee float wav files
+/// frames are decoded chunk by chunk straight into the caller's float or double buffer, the file is never loaded whole
+class WavReader {
+
+    private:
+
+    std::unique_ptr <std::FILE, detail::FileCloser> m_file;
+
+    WavFormat m_format;
+
+    /// @brief frames in the data chunk
+    size_t m_frames;
+
+    /// @brief frames read so far
+    size_t m_position = 0;
+
+    /// @brief raw bytes of one chunk, allocated once
+    std::vector <std::byte> m_bytes;
+
+    /// @brief constructor, parsing must be handled by open()
+    WavReader(std::FILE* file, const WavFormat& format, size_t frames);
+
+    template <class Real>
+    std::expected <size_t, FIRError> readFrames(std::span <Real> output);
+
+    public:
+
+    /// @brief opens a wav file and parses its header, the reader is left at the first frame
+    /// WAVE_FORMAT_PCM (16, 24 and 32 bits), WAVE_FORMAT_IEEE_FLOAT (32 and 64 bits) and their WAVE_FORMAT_EXTENSIBLE forms
+    /// are supported, chunks other than "fmt " and "data" are skipped
+    /// @param path file to be read
+    /// @return WavReader object on success, FileError if it cannot be read, InvalidFileFormat if it is not a supported wav file
+    static std::expected <WavReader, FIRError> open(const std::filesystem::path& path);
+
+    /// @brief reads the next interleaved frames, integers are scaled to [-1, 1)
+    /// @param output room for a whole number of frames, as many as fit are read
+    /// @return number of frames read on success (less than requested only at the end, 0 once all are read), FIRError on failure
+    std::expected <size_t, FIRError> read(std::span <double> output);
+
+    /// @brief reads the next interleaved frames, integers are scaled to [-1, 1)
+    /// @param output room for a whole number of frames, as many as fit are read
+    /// @return number of frames read on success (less than requested only at the end, 0 once all are read), FIRError on failure
+    std::expected <size_t, FIRError> read(std::span <float> output);
+
+    /// @brief getter for format
+    /// @return format of the samples
+    const WavFormat& getFormat() const noexcept;
+
+    /// @brief getter for frames
+    /// @return number of frames of the file
+    size_t getFrames() const noexcept;
+
+    /// @brief getter for position
+    /// @return number of frames already read
+    size_t getPosition() const noexcept;
+
+};
+
+/// @brief streaming writer of pcm and ieee float wav files
+/// frames are encoded chunk by chunk and appended to the file, the sizes in the header are filled in by close()
+class WavWriter {
+
+    private:
+
+    std::unique_ptr <std::FILE, detail::FileCloser> m_file;
+
+    WavFormat m_format;
+
+    /// @brief size of the header, the offset of the first frame
+    size_t m_header_size;
+
+    /// @brief offset of the sample count of the "fact" chunk, 0 if there is none
+    size_t m_fact_offset;
+
+    /// @brief frames written so far
+    size_t m_frames = 0;
+
+    /// @brief encoded bytes of one chunk, allocated once
+    std::vector <std::byte> m_bytes;
+
+    /// @brief constructor, validation must be handled by create()
+    WavWriter(std::FILE* file, const WavFormat& format, size_t header_size, size_t fact_offset);
+
+    template <class Real>
+    std::expected <void, FIRError> writeFrames(std::span <const Real> input);
+
+    public:
+
+    WavWriter(const WavWriter&) = delete;
+    WavWriter& operator=(const WavWriter&) = delete;
+    WavWriter(WavWriter&& other) noexcept = default;
+    WavWriter& operator=(WavWriter&& other) noexcept;
+
+    /// @brief closes the file if close() was not called, errors are lost then
+    ~WavWriter();
+
+    /// @brief creates (or replaces) a wav file and writes its header
+    /// 16 bit pcm with one or two channels gets the plain 16 byte "fmt " chunk, wider samples and more channels get
+    /// WAVE_FORMAT_EXTENSIBLE with a channel mask, ieee float gets a "fact" chunk as well
+    /// @param path file to be written
+    /// @param format layout of the samples, channels and sample rate must be nonzero
+    /// @return WavWriter object on success, FIRError on failure
+    static std::expected <WavWriter, FIRError> create(const std::filesystem::path& path, const WavFormat& format);
+
+    /// @brief appends interleaved frames, integer formats are rounded and saturated
+    /// @param input a whole number of frames
+    /// @return void on success, FIRError on failure (InvalidSize once the data would pass the 4 GiB limit of wav)
+    std::expected <void, FIRError> write(std::span <const double> input);
+
+    /// @brief appends interleaved frames, integer formats are rounded and saturated
+    /// @param input a whole number of frames
+    /// @return void on success, FIRError on failure (InvalidSize once the data would pass the 4 GiB limit of wav)
+    std::expected <void, FIRError> write(std::span <const float> input);
+
+    /// @brief writes the final sizes into the header and closes the file, nothing can be written afterwards
+    /// @return void on success, FileError on failure
+    std::expected <void, FIRError> close();
+
+    /// @brief getter for format
+    /// @return format of the samples
+    const WavFormat& getFormat() const noexcept;
+
+    /// @brief getter for frames
+    /// @return number of frames written so far
+    size_t getFrames() const noexcept;
+
+};
+
+}
@@ -6,6 +6,7 @@
 #include <cmath>
 #include <cstddef>
 #include <string>
+#include <memory>
 
 namespace oh::wnd{
 
@@ -41,9 +42,12 @@ class Window {
 
         WindowType m_type;
 
-        std::vector <double> m_coefficients;
+        size_t m_size;
+
+        /// @brief immutable coefficients, shared with every other window of the same type and size (see getCoefficients())
+        std::shared_ptr <const std::vector <double>> m_coefficients;
         
-        /// @brief used to calculate coefficients of window
+        /// @brief used to get coefficients of window from the window cache, they are calculated on the first request
         /// @return void on success, WindowError on failure
         std::expected <void, WindowError> calculateCoefficients();
     
@@ -72,7 +76,8 @@ class Window {
 
     public:
 
-        /// @brief getter for coefficientss
+        /// @brief getter for coefficientss, windows of the same type and size share one table,
+        /// which is calculated once per process and kept in a bounded thread-safe cache
         /// @return coefficients
         const std::vector <double>& getCoefficients() const;
 
@@ -91,6 +96,16 @@ class Window {
         /// @return void on success, WindowError on failure
         std::expected <void, WindowError> applyInPlace(std::vector <double>& signal) const;
 
+        /// @brief apply a window on float samples (copy), the products are calculated in double
+        /// @param signal signal to apply a window on
+        /// @return vector of floats on success, WindowError on failure
+        std::expected <std::vector <float>, WindowError> apply(const std::vector <float>& signal) const;
+
+        /// @brief apply a window on float samples
+        /// @param signal signal to apply a window on
+        /// @return void on success, WindowError on failure
+        std::expected <void, WindowError> applyInPlace(std::vector <float>& signal) const;
+
         /// @brief getter for WindowType
         /// @return WindowType enum
         const WindowType getType() const noexcept;
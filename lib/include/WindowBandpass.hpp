@@ -37,6 +37,10 @@ class WindowBandpass : public FIR {
 
     static std::expected <WindowBandpass, FIRError> create(double fc_low, double fc_high, size_t size, wnd::WindowType w_type);
 
+    /// @brief design parameters
+    /// @return {fc_low, fc_high}
+    std::vector <double> getDesignParameters() const override;
+
 };
 
 }
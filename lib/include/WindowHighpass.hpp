@@ -43,6 +43,10 @@ class WindowHighpass : public FIR {
     /// @return WindowHighpass object on success, FIRError on failure
     static std::expected <WindowHighpass, FIRError> create(double fc, size_t size, wnd::WindowType w_type);
 
+    /// @brief design parameters
+    /// @return {fc}
+    std::vector <double> getDesignParameters() const override;
+
 };
 
 }
@@ -43,6 +43,10 @@ class WindowLowpass : public FIR {
     /// @return WindowLowpass object on success, FIRError on failure
     static std::expected <WindowLowpass, FIRError> create(double fc, size_t size, wnd::WindowType w_type);
 
+    /// @brief design parameters
+    /// @return {fc}
+    std::vector <double> getDesignParameters() const override;
+
 };
 
 }
@@ -0,0 +1,226 @@
+#include "Cascade.hpp"
+#include "detail/OverlapSave.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace oh::fir {
+
+namespace {
+
+/// @brief estimated cost of one output of a stage, measured on the blocks the streaming processor works on
+double costPerOutput(size_t taps, bool symmetric, bool single_precision) noexcept {
+    const size_t outputs = std::max(taps, BasicCascade <double>::CASCADE_BLOCK_SIZE);
+    return detail::OverlapSave::estimateBestCost(taps, outputs, symmetric, single_precision) / outputs;
+}
+
+}
+
+std::string toString(CascadeMethod method) {
+    switch (method) {
+        case CascadeMethod::Automatic:
+            return "Automatic";
+        case CascadeMethod::Merged:
+            return "Merged";
+        case CascadeMethod::Staged:
+            return "Staged";
+        default:
+            return "Undefined";
+    }
+}
+
+std::expected <StoredFIR, FIRError> mergeStages(const std::vector <const FIR*>& stages) {
+    if (stages.empty()) {
+        return std::unexpected(FIRError::InvalidSize);
+    }
+
+    for (const FIR* fir : stages) {
+        if (fir == nullptr) {
+            return std::unexpected(FIRError::InvalidParameterValue);
+        }
+        if (fir -> getSize() == 0) {
+            return std::unexpected(FIRError::InvalidSize);
+        }
+    }
+
+    const FIR& first = *stages.front();
+    if (stages.size() == 1) {
+        return StoredFIR::create(first.getType(), first.getWindowType(), first.getCoefficients(), first.getDesignParameters());
+    }
+
+    ///<    the taps of the stages so far are filtered by the next stage, convolve() takes the fft for long filters
+    std::vector <double> h = first.getCoefficients();
+    for (size_t i = 1; i < stages.size(); ++i) {
+        auto w = stages[i] -> convolve(h);
+        if (!w) {
+            return std::unexpected(w.error());
+        }
+        h = std::move(*w);
+    }
+
+    return StoredFIR::create(FIRType::Fixed, wnd::WindowType::Rectangular, h, {});
+}
+
+template <class Sample, class Accumulator>
+BasicCascade <Sample, Accumulator>::BasicCascade(std::vector <BasicStreamingFIR <Sample, Accumulator>> stages, CascadeMethod method,
+                                                 size_t size, size_t stage_count)
+: m_stages(std::move(stages)), m_method(method), m_size(size), m_stage_count(stage_count) {}
+
+template <class Sample, class Accumulator>
+std::expected <BasicCascade <Sample, Accumulator>, FIRError> BasicCascade <Sample, Accumulator>::create(const std::vector <const FIR*>& stages,
+                                                                                                      CascadeMethod method) {
+    constexpr bool single_precision = std::is_same_v <Accumulator, float>;
+
+    if (stages.empty()) {
+        return std::unexpected(FIRError::InvalidSize);
+    }
+
+    size_t size = 1;
+    double staged_cost = 0.0;
+    for (const FIR* fir : stages) {
+        if (fir == nullptr) {
+            return std::unexpected(FIRError::InvalidParameterValue);
+        }
+        if (fir -> getSize() == 0) {
+            return std::unexpected(FIRError::InvalidSize);
+        }
+        size += fir -> getSize() - 1;
+        staged_cost += costPerOutput(fir -> getSize(), fir -> isSymmetric(), single_precision);
+    }
+
+    ///<    the merged taps are needed to know if they are symmetric, which decides what they cost
+    std::expected <StoredFIR, FIRError> merged = std::unexpected(FIRError::InvalidSize);
+    if (method != CascadeMethod::Staged) {
+        merged = mergeStages(stages);
+        if (!merged) {
+            return std::unexpected(merged.error());
+        }
+    }
+
+    if (method == CascadeMethod::Automatic) {
+        ///<    every stage after the first copies each sample into its buffer once more
+        staged_cost += (stages.size() - 1) * detail::OverlapSave::estimateDirectCost(1, 1, false, single_precision);
+        const double merged_cost = costPerOutput(merged -> getSize(), merged -> isSymmetric(), single_precision);
+        method = stages.size() > 1 && staged_cost < merged_cost ? CascadeMethod::Staged : CascadeMethod::Merged;
+    }
+
+    std::vector <BasicStreamingFIR <Sample, Accumulator>> processors;
+    if (method == CascadeMethod::Merged) {
+        auto stage = BasicStreamingFIR <Sample, Accumulator>::create(*merged);
+        if (!stage) {
+            return std::unexpected(stage.error());
+        }
+        processors.push_back(std::move(*stage));
+    } else {
+        processors.reserve(stages.size());
+        for (const FIR* fir : stages) {
+            auto stage = BasicStreamingFIR <Sample, Accumulator>::create(*fir);
+            if (!stage) {
+                return std::unexpected(stage.error());
+            }
+            processors.push_back(std::move(*stage));
+        }
+    }
+
+    return BasicCascade(std::move(processors), method, size, stages.size());
+}
+
+template <class Sample, class Accumulator>
+std::expected <void, FIRError> BasicCascade <Sample, Accumulator>::process(std::span <const Sample> input, std::span <Sample> output) {
+    const size_t N = input.size();
+
+    if (output.size() != N) {
+        return std::unexpected(FIRError::MismatchedSize);
+    }
+
+    size_t taps = 0;
+    for (const auto& stage : m_stages) {
+        taps += stage.getSize();
+    }
+    detail::ScopedMeasurement measurement(m_counters, N, N * taps);
+
+    if (m_method == CascadeMethod::Merged) {
+        return m_stages.front().process(input, output);
+    }
+
+    ///<    the block is copied into the output and every stage filters it in place while it is still in the cache
+    for (size_t offset = 0; offset < N; offset += CASCADE_BLOCK_SIZE) {
+        const size_t count = std::min(CASCADE_BLOCK_SIZE, N - offset);
+        std::span <Sample> block = output.subspan(offset, count);
+        if (input.data() != output.data()) {
+            std::copy(input.begin() + offset, input.begin() + offset + count, block.begin());
+        }
+
+        for (auto& stage : m_stages) {
+            if (auto p = stage.processInPlace(block); !p) {
+                return p;
+            }
+        }
+    }
+
+    return {};
+}
+
+template <class Sample, class Accumulator>
+std::expected <void, FIRError> BasicCascade <Sample, Accumulator>::processInPlace(std::span <Sample> signal) {
+    return process(signal, signal);
+}
+
+template <class Sample, class Accumulator>
+std::expected <std::vector <Sample>, FIRError> BasicCascade <Sample, Accumulator>::convolve(std::span <const Sample> signal) const {
+    const size_t N = signal.size();
+
+    if (N == 0) {
+        return std::unexpected(FIRError::InvalidSize);
+    }
+
+    ///<    the signal followed by size-1 zeros through fresh stages gives every output of the full convolution
+    std::vector <Sample> y(N + m_size - 1, Sample(0));
+    std::copy(signal.begin(), signal.end(), y.begin());
+
+    BasicCascade cascade(*this);
+    cascade.reset();
+    if (auto p = cascade.processInPlace(y); !p) {
+        return std::unexpected(p.error());
+    }
+
+    return y;
+}
+
+template <class Sample, class Accumulator>
+void BasicCascade <Sample, Accumulator>::reset() noexcept {
+    for (auto& stage : m_stages) {
+        stage.reset();
+    }
+}
+
+template <class Sample, class Accumulator>
+FilterStats BasicCascade <Sample, Accumulator>::getStats() const noexcept {
+    return m_counters.snapshot();
+}
+
+template <class Sample, class Accumulator>
+void BasicCascade <Sample, Accumulator>::resetStats() noexcept {
+    m_counters.reset();
+}
+
+template <class Sample, class Accumulator>
+size_t BasicCascade <Sample, Accumulator>::getSize() const noexcept {
+    return m_size;
+}
+
+template <class Sample, class Accumulator>
+size_t BasicCascade <Sample, Accumulator>::getStageCount() const noexcept {
+    return m_stage_count;
+}
+
+template <class Sample, class Accumulator>
+CascadeMethod BasicCascade <Sample, Accumulator>::getMethod() const noexcept {
+    return m_method;
+}
+
+template class BasicCascade <double, double>;
+template class BasicCascade <float, float>;
+template class BasicCascade <float, double>;
+
+}
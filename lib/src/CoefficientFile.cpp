@@ -0,0 +1,186 @@
+#include "CoefficientFile.hpp"
+#include "detail/Checksum.hpp"
+#include "detail/MappedFile.hpp"
+
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <system_error>
+
+namespace oh::fir {
+
+///<    the fields are copied with memcpy, which is only the file layout on little endian hosts
+static_assert(std::endian::native == std::endian::little, "coefficient files are little endian");
+
+namespace {
+
+constexpr char COEFFICIENT_FILE_MAGIC[8] = {'E', 'D', 'S', 'P', 'F', 'I', 'R', '\0'};
+
+///<    alignment of the arrays in the file, one cache line (and one avx-512 register)
+constexpr size_t COEFFICIENT_ALIGNMENT = 64;
+
+constexpr uint32_t FLAG_SYMMETRIC = 1;
+
+struct CoefficientFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t fir_type;
+    uint32_t window_type;
+    uint64_t taps;
+    uint64_t taps_offset;
+    uint64_t parameters;
+    uint64_t parameters_offset;
+    uint32_t flags;
+    uint32_t checksum;
+};
+
+static_assert(sizeof(CoefficientFileHeader) == 64, "the header is 64 bytes");
+
+constexpr size_t CHECKSUM_OFFSET = offsetof(CoefficientFileHeader, checksum);
+
+constexpr uint64_t alignUp(uint64_t size) noexcept {
+    return (size + COEFFICIENT_ALIGNMENT - 1) / COEFFICIENT_ALIGNMENT * COEFFICIENT_ALIGNMENT;
+}
+
+/// @brief crc of a file image, the checksum field counts as 0
+uint32_t checksumOf(std::span <const std::byte> data) noexcept {
+    const std::byte zero[sizeof(uint32_t)] = {};
+    uint32_t crc = detail::crc32(data.data(), CHECKSUM_OFFSET);
+    crc = detail::crc32(zero, sizeof(zero), crc);
+    const size_t rest = CHECKSUM_OFFSET + sizeof(uint32_t);
+    return detail::crc32(data.data() + rest, data.size() - rest, crc);
+}
+
+}
+
+StoredFIR::StoredFIR(FIRType type, size_t size, wnd::WindowType w_type, std::vector <double> parameters)
+: FIR(type, size, w_type), m_parameters(std::move(parameters)) {}
+
+std::expected <void, FIRError> StoredFIR::calculateCoefficients() {
+    return {};
+}
+
+std::expected <StoredFIR, FIRError> StoredFIR::create(FIRType type, wnd::WindowType w_type, std::span <const double> taps,
+                                                      std::vector <double> parameters) {
+    if (taps.empty()) {
+        return std::unexpected(FIRError::InvalidSize);
+    }
+
+    StoredFIR fir(type, taps.size(), w_type, std::move(parameters));
+
+    if (auto w = fir.setCoefficients(std::vector <double> (taps.begin(), taps.end())); !w) {
+        return std::unexpected(w.error());
+    }
+
+    return fir;
+}
+
+std::vector <double> StoredFIR::getDesignParameters() const {
+    return m_parameters;
+}
+
+std::vector <std::byte> saveCoefficients(const FIR& fir) {
+    const std::vector <double>& taps = fir.getCoefficients();
+    const std::vector <double> parameters = fir.getDesignParameters();
+
+    CoefficientFileHeader header{};
+    std::memcpy(header.magic, COEFFICIENT_FILE_MAGIC, sizeof(header.magic));
+    header.version = COEFFICIENT_FILE_VERSION;
+    header.header_size = sizeof(CoefficientFileHeader);
+    header.fir_type = static_cast <uint32_t> (fir.getType());
+    header.window_type = static_cast <uint32_t> (fir.getWindowType());
+    header.taps = taps.size();
+    header.taps_offset = alignUp(sizeof(CoefficientFileHeader));
+    header.parameters = parameters.size();
+    header.parameters_offset = header.taps_offset + alignUp(taps.size() * sizeof(double));
+    header.flags = fir.isSymmetric() ? FLAG_SYMMETRIC : 0;
+
+    ///<    the padding stays zero, so equal filters give equal files
+    std::vector <std::byte> data(header.parameters_offset + parameters.size() * sizeof(double));
+    std::memcpy(data.data() + header.taps_offset, taps.data(), taps.size() * sizeof(double));
+    if (!parameters.empty()) {
+        std::memcpy(data.data() + header.parameters_offset, parameters.data(), parameters.size() * sizeof(double));
+    }
+    std::memcpy(data.data(), &header, sizeof(header));
+
+    const uint32_t checksum = checksumOf(data);
+    std::memcpy(data.data() + CHECKSUM_OFFSET, &checksum, sizeof(checksum));
+    return data;
+}
+
+std::expected <void, FIRError> saveCoefficients(const FIR& fir, const std::filesystem::path& path) {
+    const std::vector <std::byte> data = saveCoefficients(fir);
+
+    std::filesystem::path temporary = path;
+    temporary += ".tmp";
+
+    std::FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (file == nullptr) {
+        return std::unexpected(FIRError::FileError);
+    }
+    const bool written = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+    const bool closed = std::fclose(file) == 0;
+
+    std::error_code error;
+    if (written && closed) {
+        std::filesystem::rename(temporary, path, error);
+        if (!error) {
+            return {};
+        }
+    }
+    std::filesystem::remove(temporary, error);
+    return std::unexpected(FIRError::FileError);
+}
+
+std::expected <StoredFIR, FIRError> loadCoefficients(std::span <const std::byte> data) {
+    CoefficientFileHeader header;
+    if (data.size() < sizeof(header)) {
+        return std::unexpected(FIRError::InvalidFileFormat);
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, COEFFICIENT_FILE_MAGIC, sizeof(header.magic)) != 0 || header.version == 0 ||
+        header.version > COEFFICIENT_FILE_VERSION || header.header_size != sizeof(header)) {
+        return std::unexpected(FIRError::InvalidFileFormat);
+    }
+
+    ///<    every size is checked against the file before it is used, the products cannot overflow after the first checks
+    const uint64_t size = data.size();
+    if (header.taps == 0 || header.taps > size / sizeof(double) || header.parameters > size / sizeof(double) ||
+        header.taps_offset % COEFFICIENT_ALIGNMENT != 0 || header.parameters_offset % COEFFICIENT_ALIGNMENT != 0 ||
+        header.taps_offset < sizeof(header) || header.taps_offset > size - header.taps * sizeof(double) ||
+        header.parameters_offset > size - header.parameters * sizeof(double) ||
+        header.parameters_offset + header.parameters * sizeof(double) != size ||
+        header.fir_type > static_cast <uint32_t> (FIRType::Fixed) ||
+        header.window_type > static_cast <uint32_t> (wnd::WindowType::Blackman)) {
+        return std::unexpected(FIRError::InvalidFileFormat);
+    }
+
+    if (checksumOf(data) != header.checksum) {
+        return std::unexpected(FIRError::ChecksumMismatch);
+    }
+
+    ///<    the arrays are aligned in the file, but the caller's buffer may not be, so they are copied out
+    std::vector <double> taps(header.taps);
+    std::memcpy(taps.data(), data.data() + header.taps_offset, taps.size() * sizeof(double));
+    std::vector <double> parameters(header.parameters);
+    if (!parameters.empty()) {
+        std::memcpy(parameters.data(), data.data() + header.parameters_offset, parameters.size() * sizeof(double));
+    }
+
+    return StoredFIR::create(static_cast <FIRType> (header.fir_type), static_cast <wnd::WindowType> (header.window_type), taps,
+                             std::move(parameters));
+}
+
+std::expected <StoredFIR, FIRError> loadCoefficients(const std::filesystem::path& path) {
+    auto mapped = detail::MappedFile::open(path);
+    if (!mapped) {
+        return std::unexpected(mapped.error());
+    }
+
+    return loadCoefficients(std::span <const std::byte> (mapped->getData(), mapped->getSize()));
+}
+
+}
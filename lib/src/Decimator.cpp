@@ -0,0 +1,147 @@
+#include "Decimator.hpp"
+#include "detail/Kernels.hpp"
+#include "detail/Polyphase.hpp"
+
+#include <algorithm>
+
+namespace oh::fir {
+
+namespace {
+
+///<    minimal number of outputs per chunk, the history is moved once per chunk
+constexpr size_t MIN_CHUNK_OUTPUTS = 256;
+
+}
+
+template <class Sample, class Accumulator>
+BasicDecimator <Sample, Accumulator>::BasicDecimator(const std::vector <double>& coefficients, size_t factor)
+: m_factor(factor), m_size(coefficients.size()), m_phase_length(detail::getPhaseLength(coefficients.size(), factor)), m_skip(0) {
+    const std::vector <double> reversed(coefficients.rbegin(), coefficients.rend());
+    const std::vector <double> phases = detail::splitPhases(reversed, factor);
+    m_phases.assign(phases.begin(), phases.end());
+
+    const size_t outputs = std::max(m_phase_length, MIN_CHUNK_OUTPUTS);
+    m_chunk_size = outputs * factor;
+    m_buffer.assign(factor * m_phase_length - 1 + m_chunk_size, Sample(0));
+    m_phase_input.resize(outputs + 1 + m_phase_length);
+    m_phase_output.resize(outputs + 1);
+    m_phase_sum.resize(outputs + 1);
+}
+
+template <class Sample, class Accumulator>
+std::expected <BasicDecimator <Sample, Accumulator>, FIRError> BasicDecimator <Sample, Accumulator>::create(const FIR& fir, size_t factor) {
+    if (fir.getSize() == 0) {
+        return std::unexpected(FIRError::InvalidSize);
+    }
+
+    if (factor == 0) {
+        return std::unexpected(FIRError::InvalidParameterValue);
+    }
+
+    if (factor > 1 && !detail::isBandLimited(fir.getCoefficients(), 0.5 / factor)) {
+        return std::unexpected(FIRError::InvalidParameterValue);
+    }
+
+    return BasicDecimator(fir.getCoefficients(), factor);
+}
+
+template <class Sample, class Accumulator>
+size_t BasicDecimator <Sample, Accumulator>::processChunk(Sample* output, size_t count) noexcept {
+    const size_t D = m_factor;
+    const size_t T = m_phase_length;
+    const size_t history = D * T - 1;
+    size_t outputs = 0;
+
+    if (count > m_skip) {
+        outputs = (count - m_skip - 1) / D + 1;
+
+        ///<    output m reads the window starting at m_skip+m*D, phase p of it is the input every D samples from m_skip+p
+        for (size_t p = 0; p < D; ++p) {
+            const Sample* x = m_buffer.data() + m_skip + p;
+            for (size_t i = 0; i < outputs + T - 1; ++i) {
+                m_phase_input[i] = static_cast <Accumulator> (x[i * D]);
+            }
+
+            Accumulator* y = (p == 0) ? m_phase_sum.data() : m_phase_output.data();
+            detail::directKernel(m_phase_input.data(), m_phases.data() + p * T, T, y, outputs);
+
+            if (p != 0) {
+                for (size_t m = 0; m < outputs; ++m) {
+                    m_phase_sum[m] += y[m];
+                }
+            }
+        }
+
+        ///<    rounded to Sample once per output
+        for (size_t m = 0; m < outputs; ++m) {
+            output[m] = static_cast <Sample> (m_phase_sum[m]);
+        }
+
+        m_skip = m_skip + outputs * D - count;
+    } else {
+        m_skip -= count;
+    }
+
+    ///<    the last D*T-1 samples become the history of the next chunk
+    std::copy(m_buffer.begin() + count, m_buffer.begin() + count + history, m_buffer.begin());
+
+    return outputs;
+}
+
+template <class Sample, class Accumulator>
+size_t BasicDecimator <Sample, Accumulator>::getOutputSize(size_t input_size) const noexcept {
+    return (input_size > m_skip) ? (input_size - m_skip - 1) / m_factor + 1 : 0;
+}
+
+template <class Sample, class Accumulator>
+std::expected <size_t, FIRError> BasicDecimator <Sample, Accumulator>::process(std::span <const Sample> input, std::span <Sample> output) {
+    const size_t N = input.size();
+
+    if (output.size() < getOutputSize(N)) {
+        return std::unexpected(FIRError::MismatchedSize);
+    }
+
+    const size_t history = m_factor * m_phase_length - 1;
+    size_t written = 0;
+
+    for (size_t offset = 0; offset < N; offset += m_chunk_size) {
+        const size_t count = std::min(m_chunk_size, N - offset);
+        std::copy(input.begin() + offset, input.begin() + offset + count, m_buffer.begin() + history);
+        written += processChunk(output.data() + written, count);
+    }
+
+    return written;
+}
+
+template <class Sample, class Accumulator>
+std::expected <std::vector <Sample>, FIRError> BasicDecimator <Sample, Accumulator>::process(const std::vector <Sample>& input) {
+    std::vector <Sample> w(getOutputSize(input.size()));
+
+    if (auto r = process(std::span <const Sample> (input), std::span <Sample> (w)); !r) {
+        return std::unexpected(r.error());
+    }
+
+    return w;
+}
+
+template <class Sample, class Accumulator>
+void BasicDecimator <Sample, Accumulator>::reset() noexcept {
+    std::fill(m_buffer.begin(), m_buffer.end(), Sample(0));
+    m_skip = 0;
+}
+
+template <class Sample, class Accumulator>
+size_t BasicDecimator <Sample, Accumulator>::getFactor() const noexcept {
+    return m_factor;
+}
+
+template <class Sample, class Accumulator>
+size_t BasicDecimator <Sample, Accumulator>::getSize() const noexcept {
+    return m_size;
+}
+
+template class BasicDecimator <double, double>;
+template class BasicDecimator <float, float>;
+template class BasicDecimator <float, double>;
+
+}
@@ -0,0 +1,43 @@
+#include "Executor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace oh::fir {
+
+Executor makeThreadExecutor(size_t threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    return [threads](size_t count, const std::function <void(size_t)>& task) {
+        std::atomic <size_t> next(0);
+        auto work = [&next, &task, count]() {
+            for (size_t i = next++; i < count; i = next++) {
+                task(i);
+            }
+        };
+
+        ///<    jthreads join on destruction, so a thread that fails to start does not leave the others joinable
+        std::vector <std::jthread> workers;
+        const size_t started = std::min(threads, count);
+        workers.reserve(started);
+        for (size_t t = 1; t < started; ++t) {
+            workers.emplace_back(work);
+        }
+
+        work();
+    };
+}
+
+Executor makeSerialExecutor() {
+    return [](size_t count, const std::function <void(size_t)>& task) {
+        for (size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+    };
+}
+
+}
@@ -1,7 +1,20 @@
 #include "FIR.hpp"
+#include "detail/OverlapSave.hpp"
+#include "detail/Kernels.hpp"
+#include "detail/FilterTaps.hpp"
+
+#include <algorithm>
+#include <type_traits>
 
 namespace oh::fir{
 
+namespace {
+
+///<    outputs per chunk of the parallel convolution, a multiple of the widest kernel block (4 vectors of 16 floats)
+constexpr size_t PARALLEL_CHUNK_SIZE = 64 * 1024;
+
+}
+
 std::string toString(oh::fir::FIRError fir_error){
     switch (fir_error) {
         case oh::fir::FIRError::InvalidParameterValue:
@@ -12,6 +25,12 @@ std::string toString(oh::fir::FIRError fir_error){
             return "InvalidSize";
         case oh::fir::FIRError::MismatchedSize:
             return "MismatchedSize";
+        case oh::fir::FIRError::FileError:
+            return "FileError";
+        case oh::fir::FIRError::InvalidFileFormat:
+            return "InvalidFileFormat";
+        case oh::fir::FIRError::ChecksumMismatch:
+            return "ChecksumMismatch";
         default:
             return "Unknown";
     }
@@ -27,14 +46,29 @@ std::string toString(FIRType fir_type){
             return "WindowHighpass";
         case FIRType::FrequencySampling:
             return "FrequencySampling";
+        case FIRType::Fixed:
+            return "Fixed";
         default:
             return "Undefined";
     }
 }
 
-FIR::FIR(FIRType type, size_t size)  : m_type(type), m_coefficients(size , 0.0), m_window_type(wnd::WindowType::Rectangular) {}
+std::string toString(ConvolutionMethod method){
+    switch (method) {
+        case ConvolutionMethod::Automatic:
+            return "Automatic";
+        case ConvolutionMethod::Direct:
+            return "Direct";
+        case ConvolutionMethod::FFT:
+            return "FFT";
+        default:
+            return "Undefined";
+    }
+}
+
+FIR::FIR(FIRType type, size_t size)  : m_type(type), m_window_type(wnd::WindowType::Rectangular), m_size(size) {}
 
-FIR::FIR(FIRType type, size_t size, wnd::WindowType w_type)  : m_type(type), m_coefficients(size , 0.0), m_window_type(w_type) {} 
+FIR::FIR(FIRType type, size_t size, wnd::WindowType w_type)  : m_type(type), m_window_type(w_type), m_size(size) {}
 
 std::expected <void, FIRError> FIR::checkFrequencyRange(double fc) {           
     if(fc <= 0 || fc >= 0.5) {
@@ -70,49 +104,80 @@ double FIR::sinc(double x) {
 }
 
 std::expected <void, FIRError> FIR::setCoefficients(const std::vector <double>& coefficients) {          
-    if (coefficients.size() != m_coefficients.size()) {
+    if (coefficients.size() != m_size) {
         return std::unexpected(FIRError::MismatchedSize);
-    } else {
-        m_coefficients = coefficients;
     }
+
+    ///<    a new buffer is made, copies of this filter keep the old one
+    m_taps = detail::makeFilterTaps(coefficients);
     return {};
 }
 
 std::expected <void, FIRError> FIR::normaliseCoefficients() {            
     const double eps = 1e-12;
     double sum = 0.0f;
+    std::vector <double> coefficients = getCoefficients();
 
-    for (auto& v : m_coefficients) {        
+    for (auto& v : coefficients) {        
         sum += v;
     }
 
     if (sum < eps) {
         return std::unexpected(FIRError::NormalisationFailed);
     } else {
-        for (auto& v : m_coefficients) {
+        for (auto& v : coefficients) {
             v /= sum;
         }
     }
-    return {};
+    return setCoefficients(coefficients);
 }
 
 
 const std::vector <double> & FIR::getCoefficients() const {           
-        return m_coefficients;
+    ///<    only a filter whose create() failed has no taps
+    static const std::vector <double> none;
+    return m_taps ? m_taps -> coefficients : none;
+}
+
+std::span <const double> FIR::getKernelCoefficients() const noexcept {
+    if (!m_taps) {
+        return {};
+    }
+    return m_taps -> reversed;
+}
+
+bool FIR::sharesCoefficients(const FIR& other) const noexcept {
+    return m_taps != nullptr && m_taps == other.m_taps;
 }
 
 size_t FIR::getSize() const noexcept {            
-    return m_coefficients.size();
+    return m_size;
 }
 
 FIRType FIR::getType() const noexcept {          
     return m_type;
 }
 
+FilterStats FIR::getStats() const noexcept {
+    return m_counters.snapshot();
+}
+
+void FIR::resetStats() const noexcept {
+    m_counters.reset();
+}
+
+bool FIR::isSymmetric() const noexcept {
+    return m_taps && m_taps -> symmetric;
+}
+
 wnd::WindowType FIR::getWindowType() const noexcept {          
     return m_window_type;
 }
 
+std::vector <double> FIR::getDesignParameters() const {
+    return {};
+}
+
 std::expected <void, FIRError> FIR::setWindowType(wnd::WindowType w_type) {
     m_window_type = w_type;
     if (auto w = calculateCoefficients(); !w) {
@@ -123,35 +188,218 @@ std::expected <void, FIRError> FIR::setWindowType(wnd::WindowType w_type) {
 }
 
 std::expected <std::vector<double>, FIRError> FIR::convolve(const std::vector<double>& signal) const {        
+    return convolve(signal, ConvolutionMethod::Automatic);
+}
+
+std::expected <std::vector<double>, FIRError> FIR::convolve(const std::vector<double>& signal, ConvolutionMethod method) const {        
+    return convolve <double, double> (signal, method);
+}
+
+template <class Sample, class Accumulator>
+void FIR::convolveTo(const Sample* signal, size_t size, Sample* output, ConvolutionMethod method) const {
+    static_assert(std::is_same_v <Accumulator, double> || std::is_same_v <Sample, Accumulator>, "unsupported sample and accumulator pair");
+
+    const detail::FilterTaps& taps = *m_taps;
+    const size_t N = size;
+    const size_t M = taps.coefficients.size();
+
+    const bool use_fft = method == ConvolutionMethod::FFT
+        || (method == ConvolutionMethod::Automatic
+            && detail::OverlapSave::isCheaper(M, N + M - 1, taps.symmetric, std::is_same_v <Accumulator, float>));
+
+    if (use_fft) {
+        ///<    zero history in front and zero tail behind, so every one of the N+M-1 outputs is a full block
+        std::vector <Sample> x(N + 2 * (M - 1), Sample(0));
+        std::copy(signal, signal + N, x.begin() + (M - 1));
+
+        detail::OverlapSave engine(taps.coefficients.data(), M, detail::OverlapSave::chooseFFTSize(M));
+        engine.process(x.data(), N + M - 1, output);
+        return;
+    }
+
+    ///<    the kernels walk the outputs, which needs the coefficients in reversed order and in the accumulator type
+    if constexpr (std::is_same_v <Accumulator, double>) {
+        detail::directConvolve(signal, N, taps.reversed.data(), M, taps.symmetric, output);
+    } else {
+        detail::directConvolve(signal, N, taps.reversed_float.data(), M, taps.symmetric, output);
+    }
+}
+
+template <class Sample, class Accumulator>
+std::expected <std::vector <Sample>, FIRError> FIR::convolve(const std::vector <Sample>& signal, ConvolutionMethod method) const {
     const size_t N = signal.size();
-    const size_t M = m_coefficients.size();
+    const size_t M = getCoefficients().size();
 
     if (N == 0 || M == 0) {
         return std::unexpected(FIRError::InvalidSize);
     }
 
-    std::vector<double> w(N + M - 1, 0.0);
+    detail::ScopedMeasurement measurement(m_counters, N, N * M);
 
-    for (size_t n = 0; n < N; ++n) {
-        for (size_t m = 0; m < M; ++m) {
-            w[n + m] += signal[n] * m_coefficients[m];
-        }
+    std::vector <Sample> w(N + M - 1);
+    convolveTo <Sample, Accumulator> (signal.data(), N, w.data(), method);
+
+    return w;
+}
+
+template <class Sample, class Accumulator>
+std::expected <size_t, FIRError> FIR::convolve(std::span <const std::type_identity_t <Sample>> signal, std::span <std::type_identity_t <Sample>> output,
+                                               ConvolutionMethod method) const {
+    const size_t N = signal.size();
+    const size_t M = getCoefficients().size();
+
+    if (N == 0 || M == 0) {
+        return std::unexpected(FIRError::InvalidSize);
+    }
+
+    if (output.size() < N + M - 1) {
+        return std::unexpected(FIRError::MismatchedSize);
     }
 
-        return w;
+    detail::ScopedMeasurement measurement(m_counters, N, N * M);
+    convolveTo <Sample, Accumulator> (signal.data(), N, output.data(), method);
+
+    return N + M - 1;
 }
 
+template <class Sample, class Accumulator>
+std::expected <size_t, FIRError> FIR::convolveParallel(std::span <const std::type_identity_t <Sample>> signal, std::span <std::type_identity_t <Sample>> output,
+                                                       const Executor& executor, ConvolutionMethod method) const {
+    static_assert(std::is_same_v <Accumulator, double> || std::is_same_v <Sample, Accumulator>, "unsupported sample and accumulator pair");
+
+    const size_t N = signal.size();
+    const size_t M = getCoefficients().size();
+    const size_t history = M - 1;
+
+    if (N == 0 || M == 0) {
+        return std::unexpected(FIRError::InvalidSize);
+    }
+
+    if (output.size() < N + M - 1) {
+        return std::unexpected(FIRError::MismatchedSize);
+    }
+
+    if (!executor) {
+        return std::unexpected(FIRError::InvalidParameterValue);
+    }
+
+    detail::ScopedMeasurement measurement(m_counters, N, N * M);
+
+    const detail::FilterTaps& taps = *m_taps;
+    const size_t total = N + M - 1;
+    const bool use_fft = method == ConvolutionMethod::FFT
+        || (method == ConvolutionMethod::Automatic
+            && detail::OverlapSave::isCheaper(M, total, taps.symmetric, std::is_same_v <Accumulator, float>));
+
+    ///<    a signal that fits into one chunk gains nothing from threads
+    if (N <= history + PARALLEL_CHUNK_SIZE) {
+        convolveTo <Sample, Accumulator> (signal.data(), N, output.data(), method);
+        return total;
+    }
+
+    const Sample* x = signal.data();
+    Sample* y = output.data();
+
+    if (use_fft) {
+        ///<    chunks start at multiples of the step, so every fft block reads the same samples as in convolve()
+        const size_t fft_size = detail::OverlapSave::chooseFFTSize(M);
+        const size_t step = fft_size - M + 1;
+        const size_t chunk = step * std::max <size_t> (1, PARALLEL_CHUNK_SIZE / step);
+        const size_t chunks = (total + chunk - 1) / chunk;
+
+        executor(chunks, [&](size_t c) {
+            const size_t first = c * chunk;
+            const size_t last = std::min(total, first + chunk);
+            detail::OverlapSave engine(taps.coefficients.data(), M, fft_size);
+
+            ///<    output n reads extended input n..n+M-1, which is signal n-M+1..n (zeros outside the signal)
+            if (first >= history && last <= N) {
+                engine.process(x + (first - history), last - first, y + first);
+            } else {
+                std::vector <Sample> window(last - first + history, Sample(0));
+                for (size_t i = 0; i < window.size(); ++i) {
+                    const size_t k = first + i;
+                    if (k >= history && k - history < N) {
+                        window[i] = x[k - history];
+                    }
+                }
+                engine.process(window.data(), last - first, y + first);
+            }
+        });
+
+        return total;
+    }
+
+    const Accumulator* h = nullptr;
+    if constexpr (std::is_same_v <Accumulator, double>) {
+        h = taps.reversed.data();
+    } else {
+        h = taps.reversed_float.data();
+    }
+
+    ///<    the outputs from history to N read only the signal, they are split into chunks, the edges are one more task
+    const size_t body = N - history;
+    const size_t chunks = (body + PARALLEL_CHUNK_SIZE - 1) / PARALLEL_CHUNK_SIZE;
+
+    executor(chunks + 1, [&](size_t c) {
+        if (c == chunks) {
+            detail::directConvolveEdges(x, N, h, M, taps.symmetric, y);
+            return;
+        }
+
+        const size_t first = history + c * PARALLEL_CHUNK_SIZE;
+        const size_t last = std::min(N, first + PARALLEL_CHUNK_SIZE);
+        detail::convolveKernel(x + (first - history), h, M, taps.symmetric, y + first, last - first);
+    });
+
+    return total;
+}
+
+std::expected <size_t, FIRError> FIR::convolveParallel(std::span <const double> signal, std::span <double> output, size_t threads, ConvolutionMethod method) const {
+    return convolveParallel <double, double> (signal, output, makeThreadExecutor(threads), method);
+}
+
+std::expected <size_t, FIRError> FIR::convolveParallel(std::span <const float> signal, std::span <float> output, size_t threads, ConvolutionMethod method) const {
+    return convolveParallel <float, float> (signal, output, makeThreadExecutor(threads), method);
+}
+
+std::expected <size_t, FIRError> FIR::convolve(std::span <const double> signal, std::span <double> output, ConvolutionMethod method) const {
+    return convolve <double, double> (signal, output, method);
+}
+
+std::expected <size_t, FIRError> FIR::convolve(std::span <const float> signal, std::span <float> output, ConvolutionMethod method) const {
+    return convolve <float, float> (signal, output, method);
+}
+
+template std::expected <std::vector <double>, FIRError> FIR::convolve <double, double> (const std::vector <double>&, ConvolutionMethod) const;
+template std::expected <std::vector <float>, FIRError> FIR::convolve <float, float> (const std::vector <float>&, ConvolutionMethod) const;
+template std::expected <std::vector <float>, FIRError> FIR::convolve <float, double> (const std::vector <float>&, ConvolutionMethod) const;
+template std::expected <size_t, FIRError> FIR::convolve <double, double> (std::span <const double>, std::span <double>, ConvolutionMethod) const;
+template std::expected <size_t, FIRError> FIR::convolve <float, float> (std::span <const float>, std::span <float>, ConvolutionMethod) const;
+template std::expected <size_t, FIRError> FIR::convolve <float, double> (std::span <const float>, std::span <float>, ConvolutionMethod) const;
+template std::expected <size_t, FIRError> FIR::convolveParallel <double, double> (std::span <const double>, std::span <double>, const Executor&, ConvolutionMethod) const;
+template std::expected <size_t, FIRError> FIR::convolveParallel <float, float> (std::span <const float>, std::span <float>, const Executor&, ConvolutionMethod) const;
+template std::expected <size_t, FIRError> FIR::convolveParallel <float, double> (std::span <const float>, std::span <float>, const Executor&, ConvolutionMethod) const;
+
 std::expected <std::vector<double>, FIRError> FIR::convolveInPlace(std::vector<double>& signal) const {        
-    if (auto w = convolve(signal); !w) {
+    if (auto r = convolveInPlace(signal, ConvolutionMethod::Automatic); !r) {
+        return std::unexpected(r.error());
+    }
+    return signal;
+}
+
+std::expected <void, FIRError> FIR::convolveInPlace(std::vector<double>& signal, ConvolutionMethod method) const {
+    auto w = convolve(signal, method);
+    if (!w) {
         return std::unexpected(w.error());
-    } else {
-        signal = *w;
-        return signal;
     }
+
+    signal.swap(*w);
+    return {};
 }
 
 bool FIR::operator==(const FIR& other) const {
-        if(m_coefficients == other.m_coefficients) {
+        if(sharesCoefficients(other) || getCoefficients() == other.getCoefficients()) {
             return true;
         } else {
             return false;
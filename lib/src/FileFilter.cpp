@@ -0,0 +1,251 @@
+#include "FileFilter.hpp"
+#include "StreamingFIR.hpp"
+#include "MultichannelFIR.hpp"
+#include "detail/MappedFile.hpp"
+#include "detail/SampleCodec.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <span>
+#include <system_error>
+#include <vector>
+
+namespace oh::fir {
+
+namespace {
+
+using FilePointer = std::unique_ptr <std::FILE, detail::FileCloser>;
+
+///<    MultichannelFIR puts neighbouring channels in the simd lanes, with fewer channels than a vector holds
+///<    one StreamingFIR per channel on deinterleaved copies is several times faster
+constexpr size_t MULTICHANNEL_MIN_CHANNELS = 8;
+
+/// @brief filters interleaved frames in place, keeping the history of every channel between calls
+/// many channels go through MultichannelFIR on the interleaved frames, few channels and filters long enough for
+/// StreamingFIR to switch to overlap-save run one StreamingFIR per channel instead
+class FrameFilter {
+
+    private:
+
+    std::vector <StreamingFIR> m_channels;
+
+    std::optional <MultichannelFIR> m_multi;
+
+    /// @brief one channel of a block, only used with several StreamingFIRs
+    std::vector <double> m_planar;
+
+    public:
+
+    static std::expected <FrameFilter, FIRError> create(const FIR& fir, size_t channels) {
+        FrameFilter filter;
+        auto single = StreamingFIR::create(fir);
+        if (!single) {
+            return std::unexpected(single.error());
+        }
+
+        if (channels < MULTICHANNEL_MIN_CHANNELS || single->getMethod() == ConvolutionMethod::FFT) {
+            filter.m_channels.assign(channels, *single);
+        } else {
+            auto multi = MultichannelFIR::create(fir, channels);
+            if (!multi) {
+                return std::unexpected(multi.error());
+            }
+            filter.m_multi.emplace(std::move(*multi));
+        }
+        return filter;
+    }
+
+    std::expected <void, FIRError> process(std::span <double> frames) {
+        if (m_multi) {
+            return m_multi->processInPlace(frames, ChannelLayout::Interleaved);
+        }
+        const size_t channels = m_channels.size();
+        if (channels == 1) {
+            return m_channels.front().processInPlace(frames);
+        }
+
+        const size_t count = frames.size() / channels;
+        m_planar.resize(count);
+        for (size_t c = 0; c < channels; ++c) {
+            for (size_t n = 0; n < count; ++n) {
+                m_planar[n] = frames[n * channels + c];
+            }
+            if (auto p = m_channels[c].processInPlace(m_planar); !p) {
+                return p;
+            }
+            for (size_t n = 0; n < count; ++n) {
+                frames[n * channels + c] = m_planar[n];
+            }
+        }
+        return {};
+    }
+
+};
+
+/// @brief runs frames input frames and then tail frames of silence through the filter, block_frames at a time
+/// @param read fills (first frame, frame count, samples) with input frames
+/// @param write takes (samples, frame count) filtered frames
+/// @return number of frames written on success, FIRError on failure
+template <class Read, class Write>
+std::expected <size_t, FIRError> filterBlocks(FrameFilter& filter, size_t channels, size_t frames, size_t tail, size_t block_frames,
+                                              Read&& read, Write&& write) {
+    const size_t total = frames + tail;
+    const size_t block = std::min(block_frames, std::max <size_t> (total, 1));
+    std::vector <double> samples(block * channels);
+
+    for (size_t first = 0; first < total; first += block) {
+        const size_t count = std::min(block, total - first);
+        const size_t stored = first < frames ? std::min(count, frames - first) : 0;
+
+        if (stored > 0) {
+            if (auto r = read(first, stored, samples.data()); !r) {
+                return std::unexpected(r.error());
+            }
+        }
+        std::fill(samples.begin() + stored * channels, samples.begin() + count * channels, 0.0);
+
+        if (auto p = filter.process(std::span <double> (samples.data(), count * channels)); !p) {
+            return std::unexpected(p.error());
+        }
+        if (auto w = write(samples.data(), count); !w) {
+            return std::unexpected(w.error());
+        }
+    }
+
+    return total;
+}
+
+/// @brief true if both paths name the same existing file, writing the output would destroy the input then
+bool isSameFile(const std::filesystem::path& input, const std::filesystem::path& output) {
+    std::error_code error;
+    return std::filesystem::equivalent(input, output, error);
+}
+
+}
+
+std::expected <size_t, FIRError> filterRawFile(const FIR& fir, const std::filesystem::path& input, const std::filesystem::path& output,
+                                               const RawFileOptions& options) {
+    if (options.channels == 0 || options.block_frames == 0 || getSampleSize(options.input_format) == 0 ||
+        getSampleSize(options.output_format) == 0) {
+        return std::unexpected(FIRError::InvalidParameterValue);
+    }
+
+    ///<    opening the output truncates it, which would pull the pages out from under the mapping of the input
+    if (isSameFile(input, output)) {
+        return std::unexpected(FIRError::InvalidParameterValue);
+    }
+
+    auto mapped = detail::MappedFile::open(input);
+    if (!mapped) {
+        return std::unexpected(mapped.error());
+    }
+
+    const size_t channels = options.channels;
+    const size_t input_frame = channels * getSampleSize(options.input_format);
+    const size_t output_frame = channels * getSampleSize(options.output_format);
+    if (mapped->getSize() < options.header_bytes || (mapped->getSize() - options.header_bytes) % input_frame != 0) {
+        return std::unexpected(FIRError::MismatchedSize);
+    }
+
+    auto filter = FrameFilter::create(fir, channels);
+    if (!filter) {
+        return std::unexpected(filter.error());
+    }
+
+    FilePointer file(std::fopen(output.c_str(), "wb"));
+    if (!file) {
+        return std::unexpected(FIRError::FileError);
+    }
+
+    const size_t frames = (mapped->getSize() - options.header_bytes) / input_frame;
+    const size_t tail = options.tail ? fir.getSize() - 1 : 0;
+    std::vector <std::byte> bytes(std::min(options.block_frames, std::max <size_t> (frames + tail, 1)) * output_frame);
+
+    ///<    everything before this byte has been read, the pages behind it are released block by block, including
+    ///<    those straddling two blocks
+    size_t released = 0;
+    auto read = [&](size_t first, size_t count, double* samples) -> std::expected <void, FIRError> {
+        const size_t offset = options.header_bytes + first * input_frame;
+        const size_t end = offset + count * input_frame;
+        detail::decodeSamples(mapped->getData() + offset, options.input_format, samples, count * channels);
+        mapped->release(released, end - released);
+        released = end;
+        return {};
+    };
+    auto write = [&](const double* samples, size_t count) -> std::expected <void, FIRError> {
+        detail::encodeSamples(samples, options.output_format, bytes.data(), count * channels);
+        if (std::fwrite(bytes.data(), output_frame, count, file.get()) != count) {
+            return std::unexpected(FIRError::FileError);
+        }
+        return {};
+    };
+
+    auto written = filterBlocks(*filter, channels, frames, tail, options.block_frames, read, write);
+
+    const bool closed = std::fclose(file.release()) == 0;
+    if (written && !closed) {
+        written = std::unexpected(FIRError::FileError);
+    }
+    if (!written) {
+        std::error_code error;
+        std::filesystem::remove(output, error);
+    }
+    return written;
+}
+
+std::expected <size_t, FIRError> filterWavFile(const FIR& fir, const std::filesystem::path& input, const std::filesystem::path& output,
+                                               const WavFileOptions& options) {
+    if (options.block_frames == 0 || (options.output_format && getSampleSize(*options.output_format) == 0)) {
+        return std::unexpected(FIRError::InvalidParameterValue);
+    }
+    if (isSameFile(input, output)) {
+        return std::unexpected(FIRError::InvalidParameterValue);
+    }
+
+    auto reader = WavReader::open(input);
+    if (!reader) {
+        return std::unexpected(reader.error());
+    }
+
+    WavFormat format = reader->getFormat();
+    const size_t channels = format.channels;
+    format.sample_format = options.output_format.value_or(format.sample_format);
+
+    auto filter = FrameFilter::create(fir, channels);
+    if (!filter) {
+        return std::unexpected(filter.error());
+    }
+
+    auto writer = WavWriter::create(output, format);
+    if (!writer) {
+        return std::unexpected(writer.error());
+    }
+
+    auto read = [&](size_t, size_t count, double* samples) -> std::expected <void, FIRError> {
+        auto r = reader->read(std::span <double> (samples, count * channels));
+        if (!r) {
+            return std::unexpected(r.error());
+        }
+        return {};
+    };
+    auto write = [&](const double* samples, size_t count) {
+        return writer->write(std::span <const double> (samples, count * channels));
+    };
+
+    auto written = filterBlocks(*filter, channels, reader->getFrames(), options.tail ? fir.getSize() - 1 : 0, options.block_frames,
+                                read, write);
+
+    auto closed = writer->close();
+    if (written && !closed) {
+        written = std::unexpected(closed.error());
+    }
+    if (!written) {
+        std::error_code error;
+        std::filesystem::remove(output, error);
+    }
+    return written;
+}
+
+}
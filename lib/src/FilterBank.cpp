@@ -0,0 +1,189 @@
+#include "FilterBank.hpp"
+#include "detail/Kernels.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace oh::fir {
+
+namespace {
+
+///<    input bytes per tile, about the size of an L1 data cache
+constexpr size_t TILE_BYTES = 32 * 1024;
+
+constexpr size_t MIN_TILE_SIZE = 256;
+
+}
+
+template <class Sample, class Accumulator>
+BasicFilterBank <Sample, Accumulator>::BasicFilterBank(const std::vector <const FIR*>& filters, Executor executor, size_t threads)
+: m_max_size(0), m_threads(threads), m_executor(std::move(executor)) {
+    for (const FIR* fir : filters) {
+        const std::span <const double> h = fir -> getKernelCoefficients();
+        m_offsets.push_back(m_reversed_coefficients.size());
+        m_sizes.push_back(h.size());
+        m_symmetric.push_back(fir -> isSymmetric());
+        m_reversed_coefficients.insert(m_reversed_coefficients.end(), h.begin(), h.end());
+        m_max_size = std::max(m_max_size, h.size());
+    }
+}
+
+template <class Sample, class Accumulator>
+std::expected <BasicFilterBank <Sample, Accumulator>, FIRError> BasicFilterBank <Sample, Accumulator>::create(const std::vector <const FIR*>& filters, size_t threads) {
+    return create(filters, threads == 1 ? makeSerialExecutor() : makeThreadExecutor(threads), threads);
+}
+
+template <class Sample, class Accumulator>
+std::expected <BasicFilterBank <Sample, Accumulator>, FIRError> BasicFilterBank <Sample, Accumulator>::create(const std::vector <const FIR*>& filters,
+                                                                                                            Executor executor, size_t threads) {
+    if (filters.empty()) {
+        return std::unexpected(FIRError::InvalidSize);
+    }
+
+    if (threads == 0 || !executor) {
+        return std::unexpected(FIRError::InvalidParameterValue);
+    }
+
+    for (const FIR* fir : filters) {
+        if (fir == nullptr) {
+            return std::unexpected(FIRError::InvalidParameterValue);
+        }
+        if (fir -> getSize() == 0) {
+            return std::unexpected(FIRError::InvalidSize);
+        }
+    }
+
+    return BasicFilterBank(filters, std::move(executor), threads);
+}
+
+template <class Sample, class Accumulator>
+void BasicFilterBank <Sample, Accumulator>::run(const Sample* padded, size_t size, Sample* const* rows, size_t first, size_t last) const noexcept {
+    const size_t P = m_max_size - 1;
+    const size_t L = size + P;
+    const size_t tile = std::max(MIN_TILE_SIZE, TILE_BYTES / sizeof(Sample) - std::min(P, TILE_BYTES / sizeof(Sample)));
+
+    ///<    filter k needs an extended input with M_k-1 samples of history, which starts P-(M_k-1) samples into the padding
+    for (size_t t = 0; t < L; t += tile) {
+        for (size_t k = first; k < last; ++k) {
+            const size_t M = m_sizes[k];
+            const size_t outputs = size + M - 1;
+            if (t >= outputs) {
+                continue;
+            }
+
+            const size_t count = std::min(tile, outputs - t);
+            detail::convolveKernel(padded + (P - (M - 1)) + t, m_reversed_coefficients.data() + m_offsets[k], M, static_cast <bool> (m_symmetric[k]),
+                                   rows[k] + t, count);
+        }
+    }
+}
+
+template <class Sample, class Accumulator>
+void BasicFilterBank <Sample, Accumulator>::runAll(std::span <const Sample> signal, Sample* const* rows) const {
+    const size_t N = signal.size();
+    const size_t P = m_max_size - 1;
+    const size_t K = m_sizes.size();
+
+    std::vector <Sample> padded(N + 2 * P, Sample(0));
+    std::copy(signal.begin(), signal.end(), padded.begin() + P);
+
+    const size_t threads = std::min(m_threads, K);
+    if (threads == 1) {
+        run(padded.data(), N, rows, 0, K);
+        return;
+    }
+
+    ///<    every task of the executor gets a contiguous range of filters with about the same number of multiply-adds
+    size_t total = 0;
+    for (auto M : m_sizes) {
+        total += M;
+    }
+
+    std::vector <size_t> bounds{0};
+    size_t done = 0;
+    for (size_t i = 1; i <= threads && bounds.back() < K; ++i) {
+        const size_t target = total * i / threads;
+        size_t last = bounds.back();
+        while (last < K && (done < target || last == bounds.back())) {
+            done += m_sizes[last];
+            ++last;
+        }
+        if (i == threads) {
+            last = K;
+        }
+        bounds.push_back(last);
+    }
+
+    m_executor(bounds.size() - 1, [&](size_t i) {
+        run(padded.data(), N, rows, bounds[i], bounds[i + 1]);
+    });
+}
+
+template <class Sample, class Accumulator>
+std::expected <std::vector <std::vector <Sample>>, FIRError> BasicFilterBank <Sample, Accumulator>::convolve(std::span <const Sample> signal) const {
+    if (signal.empty()) {
+        return std::unexpected(FIRError::InvalidSize);
+    }
+
+    const size_t K = m_sizes.size();
+    std::vector <std::vector <Sample>> w(K);
+    std::vector <Sample*> rows(K);
+    for (size_t k = 0; k < K; ++k) {
+        w[k].resize(signal.size() + m_sizes[k] - 1);
+        rows[k] = w[k].data();
+    }
+
+    runAll(signal, rows.data());
+
+    return w;
+}
+
+template <class Sample, class Accumulator>
+std::expected <size_t, FIRError> BasicFilterBank <Sample, Accumulator>::convolve(std::span <const Sample> signal, std::span <Sample> output) const {
+    if (signal.empty()) {
+        return std::unexpected(FIRError::InvalidSize);
+    }
+
+    const size_t K = m_sizes.size();
+    const size_t row = signal.size() + m_max_size - 1;
+
+    if (output.size() < K * row) {
+        return std::unexpected(FIRError::MismatchedSize);
+    }
+
+    std::vector <Sample*> rows(K);
+    for (size_t k = 0; k < K; ++k) {
+        rows[k] = output.data() + k * row;
+        std::fill(rows[k] + signal.size() + m_sizes[k] - 1, rows[k] + row, Sample(0));
+    }
+
+    runAll(signal, rows.data());
+
+    return row;
+}
+
+template <class Sample, class Accumulator>
+size_t BasicFilterBank <Sample, Accumulator>::getFilterCount() const noexcept {
+    return m_sizes.size();
+}
+
+template <class Sample, class Accumulator>
+size_t BasicFilterBank <Sample, Accumulator>::getSize(size_t filter) const noexcept {
+    return filter < m_sizes.size() ? m_sizes[filter] : 0;
+}
+
+template <class Sample, class Accumulator>
+size_t BasicFilterBank <Sample, Accumulator>::getMaxSize() const noexcept {
+    return m_max_size;
+}
+
+template <class Sample, class Accumulator>
+size_t BasicFilterBank <Sample, Accumulator>::getThreadCount() const noexcept {
+    return m_threads;
+}
+
+template class BasicFilterBank <double, double>;
+template class BasicFilterBank <float, float>;
+template class BasicFilterBank <float, double>;
+
+}
@@ -0,0 +1,107 @@
+#include "FilterRegistry.hpp"
+#include "WindowLowpass.hpp"
+#include "WindowHighpass.hpp"
+#include "WindowBandpass.hpp"
+#include "FrequencySampling.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+namespace oh::fir {
+
+FilterRegistry::Key FilterRegistry::makeKey(FIRType type, wnd::WindowType w_type, size_t size, const std::vector <double>& parameters) {
+    Key key{type, w_type, size, std::vector <uint64_t> (parameters.size())};
+    for (size_t i = 0; i < parameters.size(); ++i) {
+        key.parameters[i] = std::bit_cast <uint64_t> (parameters[i]);
+    }
+    return key;
+}
+
+FilterHandle FilterRegistry::find(const Key& key, const FIR* match) const {
+    auto [first, last] = m_filters.equal_range(key);
+    for (auto it = first; it != last; ++it) {
+        FilterHandle fir = it -> second.lock();
+        if (fir && (match == nullptr || fir -> sharesCoefficients(*match) || fir -> getCoefficients() == match -> getCoefficients())) {
+            return fir;
+        }
+    }
+    return nullptr;
+}
+
+FilterHandle FilterRegistry::insert(Key key, FilterHandle fir, bool match_coefficients) {
+    std::lock_guard lock(m_mutex);
+
+    if (FilterHandle found = find(key, match_coefficients ? fir.get() : nullptr)) {
+        return found;
+    }
+
+    ///<    freed filters leave their entries behind, they are dropped whenever the map has doubled since the last sweep
+    if (m_filters.size() >= m_prune_at) {
+        std::erase_if(m_filters, [](const auto& entry) { return entry.second.expired(); });
+        m_prune_at = std::max <size_t> (16, 2 * m_filters.size());
+    }
+
+    m_filters.emplace(std::move(key), fir);
+    return fir;
+}
+
+template <class Create>
+std::expected <FilterHandle, FIRError> FilterRegistry::findOrCreate(Key key, Create&& create) {
+    {
+        std::lock_guard lock(m_mutex);
+        if (FilterHandle found = find(key, nullptr)) {
+            return found;
+        }
+    }
+
+    ///<    designed outside the lock, if another thread registered the same design meanwhile its filter is returned
+    auto fir = create();
+    if (!fir) {
+        return std::unexpected(fir.error());
+    }
+
+    using Filter = typename decltype(fir)::value_type;
+    return insert(std::move(key), std::make_shared <const Filter> (std::move(*fir)), false);
+}
+
+FilterRegistry& FilterRegistry::global() {
+    static FilterRegistry registry;
+    return registry;
+}
+
+std::expected <FilterHandle, FIRError> FilterRegistry::lowpass(double fc, size_t size, wnd::WindowType w_type) {
+    return findOrCreate(makeKey(FIRType::WindowLowpass, w_type, size, {fc}), [&] {
+        return WindowLowpass::create(fc, size, w_type);
+    });
+}
+
+std::expected <FilterHandle, FIRError> FilterRegistry::highpass(double fc, size_t size, wnd::WindowType w_type) {
+    return findOrCreate(makeKey(FIRType::WindowHighpass, w_type, size, {fc}), [&] {
+        return WindowHighpass::create(fc, size, w_type);
+    });
+}
+
+std::expected <FilterHandle, FIRError> FilterRegistry::bandpass(double fc_low, double fc_high, size_t size, wnd::WindowType w_type) {
+    return findOrCreate(makeKey(FIRType::WindowBandpass, w_type, size, {fc_low, fc_high}), [&] {
+        return WindowBandpass::create(fc_low, fc_high, size, w_type);
+    });
+}
+
+std::expected <FilterHandle, FIRError> FilterRegistry::frequencySampling(const std::vector <double>& half_frequency_spectrum) {
+    const size_t size = 2 * half_frequency_spectrum.size() + 1;
+    return findOrCreate(makeKey(FIRType::FrequencySampling, wnd::WindowType::Rectangular, size, half_frequency_spectrum), [&] {
+        return FrequencySampling::create(half_frequency_spectrum);
+    });
+}
+
+size_t FilterRegistry::size() const {
+    std::lock_guard lock(m_mutex);
+    size_t alive = 0;
+    for (const auto& entry : m_filters) {
+        alive += entry.second.expired() ? 0 : 1;
+    }
+    return alive;
+}
+
+}
@@ -0,0 +1,90 @@
+#include "FixedPointFIR.hpp"
+#include "detail/Kernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace oh::fir {
+
+template <class Sample>
+BasicFixedPointFIR <Sample>::BasicFixedPointFIR(const std::vector <double>& coefficients)
+: m_coefficients(coefficients.size()), m_quantisation_error(0.0) {
+    const double scale = std::ldexp(1.0, FRACTIONAL_BITS);
+
+    for (size_t n = 0; n < coefficients.size(); ++n) {
+        m_coefficients[n] = quantise(coefficients[n]);
+        m_quantisation_error = std::max(m_quantisation_error, std::abs(coefficients[n] - m_coefficients[n] / scale));
+    }
+
+    m_reversed_coefficients.assign(m_coefficients.rbegin(), m_coefficients.rend());
+}
+
+template <class Sample>
+std::expected <BasicFixedPointFIR <Sample>, FIRError> BasicFixedPointFIR <Sample>::create(const FIR& fir) {
+    if (fir.getSize() == 0 || fir.getSize() > MAX_SIZE) {
+        return std::unexpected(FIRError::InvalidSize);
+    }
+
+    return BasicFixedPointFIR(fir.getCoefficients());
+}
+
+template <class Sample>
+Sample BasicFixedPointFIR <Sample>::quantise(double value) noexcept {
+    ///<    the lowest value (-1.0) is left out, which keeps the range symmetric and the Q15 multiply-adds from overflowing
+    const double largest = std::numeric_limits <Sample>::max();
+    const double scaled = std::round(value * std::ldexp(1.0, FRACTIONAL_BITS));
+    return static_cast <Sample> (std::clamp(scaled, -largest, largest));
+}
+
+template <class Sample>
+std::expected <std::vector <Sample>, FIRError> BasicFixedPointFIR <Sample>::convolve(const std::vector <Sample>& signal) const {
+    const size_t N = signal.size();
+    const size_t M = m_reversed_coefficients.size();
+
+    if (N == 0) {
+        return std::unexpected(FIRError::InvalidSize);
+    }
+
+    std::vector <Sample> w(N + M - 1);
+    detail::directConvolve(signal.data(), N, m_reversed_coefficients.data(), M, w.data());
+
+    return w;
+}
+
+template <class Sample>
+std::expected <size_t, FIRError> BasicFixedPointFIR <Sample>::convolve(std::span <const Sample> signal, std::span <Sample> output) const {
+    const size_t N = signal.size();
+    const size_t M = m_reversed_coefficients.size();
+
+    if (N == 0) {
+        return std::unexpected(FIRError::InvalidSize);
+    }
+
+    if (output.size() < N + M - 1) {
+        return std::unexpected(FIRError::MismatchedSize);
+    }
+
+    detail::directConvolve(signal.data(), N, m_reversed_coefficients.data(), M, output.data());
+
+    return N + M - 1;
+}
+
+template <class Sample>
+const std::vector <Sample>& BasicFixedPointFIR <Sample>::getCoefficients() const noexcept {
+    return m_coefficients;
+}
+
+template <class Sample>
+double BasicFixedPointFIR <Sample>::getQuantisationError() const noexcept {
+    return m_quantisation_error;
+}
+
+template <class Sample>
+size_t BasicFixedPointFIR <Sample>::getSize() const noexcept {
+    return m_coefficients.size();
+}
+
+template class BasicFixedPointFIR <int16_t>;
+template class BasicFixedPointFIR <int32_t>;
+
+}
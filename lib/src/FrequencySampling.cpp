@@ -1,4 +1,7 @@
 #include "FrequencySampling.hpp"
+#include "detail/FFT.hpp"
+
+#include <complex>
 
 namespace oh::fir {
 
@@ -11,18 +14,22 @@ FrequencySampling::FrequencySampling(const std::vector<double>& half_frequency_s
 std::expected <void, FIRError> FrequencySampling::calculateCoefficients() {
     const size_t K = m_half_frequency_spectrum.size();
     const size_t N = 2 * K + 1;
-    const double center = (N - 1) / 2.0;
 
-    std::vector<double> h(N, 0.0);
+    ///<    h[n] = (A[0] + 2 * sum of A[k]*cos(2*pi*k*(n-center)/N)) / N for 0 < k < K is the inverse dft of the
+    ///<    spectrum with A[k] mirrored to the bins N-k, taken at (n-center) mod N, N is odd so it goes through bluestein
+    std::vector <std::complex <double>> spectrum(N, {0.0, 0.0});
+    spectrum[0] = m_half_frequency_spectrum[0];
+    for (size_t k = 1; k < K; ++k) {
+        spectrum[k] = m_half_frequency_spectrum[k];
+        spectrum[N - k] = m_half_frequency_spectrum[k];
+    }
 
-    for (size_t n = 0; n < N; ++n) {
-        double sum = m_half_frequency_spectrum[0];
+    detail::Bluestein(N).inverse(spectrum.data());
 
-        for (size_t k = 1; k < K; ++k) {
-            sum += 2.0 * m_half_frequency_spectrum[k] * std::cos(2.0 * std::numbers::pi * k * (n - center) / N);
-        }
+    std::vector<double> h(N, 0.0);
 
-        h[n] = sum / N;
+    for (size_t n = 0; n < N; ++n) {
+        h[n] = spectrum[(n + N - K) % N].real() / N;
     }
 
     auto win = wnd::Window::create(getWindowType(), N);
@@ -63,4 +70,8 @@ std::vector<double> FrequencySampling::getFrequencyHalfSpectrum() {
     return m_half_frequency_spectrum;
 }
 
+std::vector <double> FrequencySampling::getDesignParameters() const {
+    return m_half_frequency_spectrum;
+}
+
 }
\ No newline at end of file
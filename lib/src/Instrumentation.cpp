@@ -0,0 +1,83 @@
+#include "Instrumentation.hpp"
+
+#include <atomic>
+
+namespace {
+
+thread_local uint64_t thread_allocations = 0;
+
+std::atomic <uint64_t> allocations{0};
+
+}
+
+namespace oh::fir::detail {
+
+uint64_t getThreadAllocationCount() noexcept {
+    return thread_allocations;
+}
+
+uint64_t getAllocationCount() noexcept {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+void countAllocation() noexcept {
+    ++thread_allocations;
+    allocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+}
+
+#ifdef EASYDSP_INSTRUMENTATION
+
+namespace oh::fir::detail {
+
+Counters::Counters(const Counters& other) noexcept {
+    assign(other.snapshot());
+}
+
+Counters& Counters::operator=(const Counters& other) noexcept {
+    if (this != &other) {
+        assign(other.snapshot());
+    }
+    return *this;
+}
+
+void Counters::assign(const FilterStats& stats) noexcept {
+    m_calls.store(stats.calls, std::memory_order_relaxed);
+    m_samples.store(stats.samples, std::memory_order_relaxed);
+    m_macs.store(stats.macs, std::memory_order_relaxed);
+    m_total_ns.store(stats.total_ns, std::memory_order_relaxed);
+    m_max_ns.store(stats.max_ns, std::memory_order_relaxed);
+    m_allocations.store(stats.allocations, std::memory_order_relaxed);
+}
+
+void Counters::record(uint64_t samples, uint64_t macs, uint64_t ns, uint64_t allocations) noexcept {
+    m_calls.fetch_add(1, std::memory_order_relaxed);
+    m_samples.fetch_add(samples, std::memory_order_relaxed);
+    m_macs.fetch_add(macs, std::memory_order_relaxed);
+    m_total_ns.fetch_add(ns, std::memory_order_relaxed);
+    m_allocations.fetch_add(allocations, std::memory_order_relaxed);
+
+    uint64_t max = m_max_ns.load(std::memory_order_relaxed);
+    while (ns > max && !m_max_ns.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+    }
+}
+
+FilterStats Counters::snapshot() const noexcept {
+    return {
+        m_calls.load(std::memory_order_relaxed),
+        m_samples.load(std::memory_order_relaxed),
+        m_macs.load(std::memory_order_relaxed),
+        m_total_ns.load(std::memory_order_relaxed),
+        m_max_ns.load(std::memory_order_relaxed),
+        m_allocations.load(std::memory_order_relaxed)
+    };
+}
+
+void Counters::reset() noexcept {
+    assign({});
+}
+
+}
+
+#endif
@@ -0,0 +1,126 @@
+#include "Interpolator.hpp"
+#include "detail/Kernels.hpp"
+#include "detail/Polyphase.hpp"
+
+#include <algorithm>
+
+namespace oh::fir {
+
+namespace {
+
+///<    minimal number of input samples per chunk, the history is moved once per chunk
+constexpr size_t MIN_CHUNK_SIZE = 256;
+
+}
+
+template <class Sample, class Accumulator>
+BasicInterpolator <Sample, Accumulator>::BasicInterpolator(const std::vector <double>& coefficients, size_t factor, double gain)
+: m_factor(factor), m_size(coefficients.size()), m_phase_length(detail::getPhaseLength(coefficients.size(), factor)) {
+    const size_t M = coefficients.size();
+    const size_t T = m_phase_length;
+
+    ///<    sub-filter q uses h[q], h[q+factor], h[q+2*factor]..., stored reversed for the kernels, missing ones are zero
+    m_phases.assign(factor * T, Accumulator(0));
+    for (size_t q = 0; q < factor; ++q) {
+        for (size_t j = 0; j < T; ++j) {
+            const size_t k = (T - 1 - j) * factor + q;
+            if (k < M) {
+                m_phases[q * T + j] = static_cast <Accumulator> (gain * coefficients[k]);
+            }
+        }
+    }
+
+    m_chunk_size = std::max(T, MIN_CHUNK_SIZE);
+    m_buffer.assign(T - 1 + m_chunk_size, Sample(0));
+    m_phase_output.resize(m_chunk_size);
+}
+
+template <class Sample, class Accumulator>
+std::expected <BasicInterpolator <Sample, Accumulator>, FIRError> BasicInterpolator <Sample, Accumulator>::create(const FIR& fir, size_t factor) {
+    return create(fir, factor, static_cast <double> (factor));
+}
+
+template <class Sample, class Accumulator>
+std::expected <BasicInterpolator <Sample, Accumulator>, FIRError> BasicInterpolator <Sample, Accumulator>::create(const FIR& fir, size_t factor, double gain) {
+    if (fir.getSize() == 0) {
+        return std::unexpected(FIRError::InvalidSize);
+    }
+
+    if (factor == 0 || gain == 0.0) {
+        return std::unexpected(FIRError::InvalidParameterValue);
+    }
+
+    if (factor > 1 && !detail::isBandLimited(fir.getCoefficients(), 0.5 / factor)) {
+        return std::unexpected(FIRError::InvalidParameterValue);
+    }
+
+    return BasicInterpolator(fir.getCoefficients(), factor, gain);
+}
+
+template <class Sample, class Accumulator>
+void BasicInterpolator <Sample, Accumulator>::processChunk(Sample* output, size_t count) noexcept {
+    const size_t L = m_factor;
+    const size_t T = m_phase_length;
+
+    ///<    every sub-filter runs on the same input, its outputs are every L-th sample of the result
+    for (size_t q = 0; q < L; ++q) {
+        detail::directKernel(m_buffer.data(), m_phases.data() + q * T, T, m_phase_output.data(), count);
+        for (size_t m = 0; m < count; ++m) {
+            output[m * L + q] = m_phase_output[m];
+        }
+    }
+
+    ///<    the last T-1 samples become the history of the next chunk
+    std::copy(m_buffer.begin() + count, m_buffer.begin() + count + T - 1, m_buffer.begin());
+}
+
+template <class Sample, class Accumulator>
+std::expected <size_t, FIRError> BasicInterpolator <Sample, Accumulator>::process(std::span <const Sample> input, std::span <Sample> output) {
+    const size_t N = input.size();
+
+    if (output.size() < N * m_factor) {
+        return std::unexpected(FIRError::MismatchedSize);
+    }
+
+    const size_t history = m_phase_length - 1;
+
+    for (size_t offset = 0; offset < N; offset += m_chunk_size) {
+        const size_t count = std::min(m_chunk_size, N - offset);
+        std::copy(input.begin() + offset, input.begin() + offset + count, m_buffer.begin() + history);
+        processChunk(output.data() + offset * m_factor, count);
+    }
+
+    return N * m_factor;
+}
+
+template <class Sample, class Accumulator>
+std::expected <std::vector <Sample>, FIRError> BasicInterpolator <Sample, Accumulator>::process(const std::vector <Sample>& input) {
+    std::vector <Sample> w(input.size() * m_factor);
+
+    if (auto r = process(std::span <const Sample> (input), std::span <Sample> (w)); !r) {
+        return std::unexpected(r.error());
+    }
+
+    return w;
+}
+
+template <class Sample, class Accumulator>
+void BasicInterpolator <Sample, Accumulator>::reset() noexcept {
+    std::fill(m_buffer.begin(), m_buffer.end(), Sample(0));
+}
+
+template <class Sample, class Accumulator>
+size_t BasicInterpolator <Sample, Accumulator>::getFactor() const noexcept {
+    return m_factor;
+}
+
+template <class Sample, class Accumulator>
+size_t BasicInterpolator <Sample, Accumulator>::getSize() const noexcept {
+    return m_size;
+}
+
+template class BasicInterpolator <double, double>;
+template class BasicInterpolator <float, float>;
+template class BasicInterpolator <float, double>;
+
+}
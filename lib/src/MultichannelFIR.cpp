@@ -0,0 +1,173 @@
+#include "MultichannelFIR.hpp"
+#include "detail/Kernels.hpp"
+
+#include <algorithm>
+
+namespace oh::fir {
+
+namespace {
+
+///<    minimal number of frames per chunk, the history is moved once per chunk
+constexpr size_t MIN_CHUNK_FRAMES = 256;
+
+}
+
+std::string toString(ChannelLayout layout) {
+    switch (layout) {
+        case ChannelLayout::Planar:
+            return "Planar";
+        case ChannelLayout::Interleaved:
+            return "Interleaved";
+        default:
+            return "Undefined";
+    }
+}
+
+template <class Sample, class Accumulator>
+BasicMultichannelFIR <Sample, Accumulator>::BasicMultichannelFIR(const FIR& fir, size_t channels)
+: m_reversed_coefficients(fir.getKernelCoefficients().begin(), fir.getKernelCoefficients().end()), m_symmetric(fir.isSymmetric()), m_channels(channels),
+  m_chunk_frames(std::max(fir.getCoefficients().size(), MIN_CHUNK_FRAMES)) {
+    m_buffer.assign((fir.getCoefficients().size() - 1 + m_chunk_frames) * channels, Sample(0));
+    m_output.resize(m_chunk_frames * channels);
+}
+
+template <class Sample, class Accumulator>
+std::expected <BasicMultichannelFIR <Sample, Accumulator>, FIRError> BasicMultichannelFIR <Sample, Accumulator>::create(const FIR& fir, size_t channels) {
+    if (fir.getSize() == 0 || channels == 0) {
+        return std::unexpected(FIRError::InvalidSize);
+    }
+
+    return BasicMultichannelFIR(fir, channels);
+}
+
+template <class Sample, class Accumulator>
+std::expected <void, FIRError> BasicMultichannelFIR <Sample, Accumulator>::process(std::span <const Sample> input, std::span <Sample> output, ChannelLayout layout) {
+    const size_t C = m_channels;
+    const size_t M = m_reversed_coefficients.size();
+
+    if (input.size() % C != 0 || output.size() != input.size()) {
+        return std::unexpected(FIRError::MismatchedSize);
+    }
+
+    const size_t N = input.size() / C;
+    const size_t history = M - 1;
+    Sample* block = m_buffer.data() + history * C;
+
+    ///<    every chunk is copied into the buffer before any of its outputs is written, so input and output may alias
+    for (size_t offset = 0; offset < N; offset += m_chunk_frames) {
+        const size_t count = std::min(m_chunk_frames, N - offset);
+
+        if (layout == ChannelLayout::Interleaved) {
+            std::copy(input.begin() + offset * C, input.begin() + (offset + count) * C, block);
+            detail::multichannelKernel(m_buffer.data(), m_reversed_coefficients.data(), M, m_symmetric, C, output.data() + offset * C, count);
+        } else {
+            for (size_t c = 0; c < C; ++c) {
+                const Sample* x = input.data() + c * N + offset;
+                for (size_t f = 0; f < count; ++f) {
+                    block[f * C + c] = x[f];
+                }
+            }
+
+            detail::multichannelKernel(m_buffer.data(), m_reversed_coefficients.data(), M, m_symmetric, C, m_output.data(), count);
+
+            for (size_t c = 0; c < C; ++c) {
+                Sample* y = output.data() + c * N + offset;
+                for (size_t f = 0; f < count; ++f) {
+                    y[f] = m_output[f * C + c];
+                }
+            }
+        }
+
+        ///<    the last M-1 frames become the history of the next chunk
+        std::copy(m_buffer.begin() + count * C, m_buffer.begin() + (count + history) * C, m_buffer.begin());
+    }
+
+    return {};
+}
+
+template <class Sample, class Accumulator>
+std::expected <void, FIRError> BasicMultichannelFIR <Sample, Accumulator>::processInPlace(std::span <Sample> signal, ChannelLayout layout) {
+    return process(signal, signal, layout);
+}
+
+template <class Sample, class Accumulator>
+std::expected <size_t, FIRError> BasicMultichannelFIR <Sample, Accumulator>::convolve(std::span <const Sample> input, std::span <Sample> output, ChannelLayout layout) const {
+    const size_t C = m_channels;
+    const size_t M = m_reversed_coefficients.size();
+
+    if (input.empty()) {
+        return std::unexpected(FIRError::InvalidSize);
+    }
+
+    if (input.size() % C != 0) {
+        return std::unexpected(FIRError::MismatchedSize);
+    }
+
+    const size_t N = input.size() / C;
+    const size_t L = N + M - 1;
+
+    if (output.size() < L * C) {
+        return std::unexpected(FIRError::MismatchedSize);
+    }
+
+    ///<    the input followed by M-1 zero frames is streamed through a local buffer chunk by chunk, like process() does,
+    ///<    so the scratch memory depends on the filter and the channels, not on the length of the signal
+    const size_t history = M - 1;
+    std::vector <Sample> buffer((history + m_chunk_frames) * C, Sample(0));
+    std::vector <Sample> y(layout == ChannelLayout::Planar ? m_chunk_frames * C : 0);
+    Sample* block = buffer.data() + history * C;
+
+    for (size_t first = 0; first < L; first += m_chunk_frames) {
+        const size_t count = std::min(m_chunk_frames, L - first);
+        const size_t stored = first < N ? std::min(count, N - first) : 0;
+
+        if (layout == ChannelLayout::Interleaved) {
+            std::copy(input.begin() + first * C, input.begin() + (first + stored) * C, block);
+        } else {
+            for (size_t c = 0; c < C; ++c) {
+                const Sample* x = input.data() + c * N + first;
+                for (size_t f = 0; f < stored; ++f) {
+                    block[f * C + c] = x[f];
+                }
+            }
+        }
+        std::fill(block + stored * C, block + count * C, Sample(0));
+
+        Sample* out = (layout == ChannelLayout::Interleaved) ? output.data() + first * C : y.data();
+        detail::multichannelKernel(buffer.data(), m_reversed_coefficients.data(), M, m_symmetric, C, out, count);
+
+        if (layout == ChannelLayout::Planar) {
+            for (size_t c = 0; c < C; ++c) {
+                Sample* z = output.data() + c * L + first;
+                for (size_t f = 0; f < count; ++f) {
+                    z[f] = y[f * C + c];
+                }
+            }
+        }
+
+        std::copy(buffer.begin() + count * C, buffer.begin() + (count + history) * C, buffer.begin());
+    }
+
+    return L * C;
+}
+
+template <class Sample, class Accumulator>
+void BasicMultichannelFIR <Sample, Accumulator>::reset() noexcept {
+    std::fill(m_buffer.begin(), m_buffer.end(), Sample(0));
+}
+
+template <class Sample, class Accumulator>
+size_t BasicMultichannelFIR <Sample, Accumulator>::getChannels() const noexcept {
+    return m_channels;
+}
+
+template <class Sample, class Accumulator>
+size_t BasicMultichannelFIR <Sample, Accumulator>::getSize() const noexcept {
+    return m_reversed_coefficients.size();
+}
+
+template class BasicMultichannelFIR <double, double>;
+template class BasicMultichannelFIR <float, float>;
+template class BasicMultichannelFIR <float, double>;
+
+}
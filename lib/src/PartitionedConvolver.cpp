@@ -0,0 +1,166 @@
+#include "PartitionedConvolver.hpp"
+#include "detail/UniformPartition.hpp"
+
+#include <algorithm>
+
+namespace oh::fir {
+
+namespace {
+
+constexpr size_t MIN_BLOCK_SIZE = 8;
+
+bool isValidBlockSize(size_t block_size) {
+    return block_size >= MIN_BLOCK_SIZE && detail::nextPowerOfTwo(block_size) == block_size;
+}
+
+}
+
+PartitionedConvolver::PartitionedConvolver(const std::vector <double>& coefficients, size_t block_size, size_t max_block_size)
+: m_size(coefficients.size()), m_block_size(block_size), m_input(block_size, 0.0), m_output(block_size, 0.0), m_fill(0) {
+    const size_t M = coefficients.size();
+    size_t offset = 0;
+    size_t block = block_size;
+
+    ///<    every stage but the last takes two partitions, then the block size doubles
+    ///<    a stage with block b starting at offset o is delayed by o+block_size-b, which is never negative here
+    while (offset < M) {
+        const size_t count = (block == max_block_size) ? M - offset : std::min(M - offset, 2 * block);
+        m_stages.emplace_back(coefficients.data() + offset, count, block, offset + block_size - block);
+        offset += count;
+        block = std::min(2 * block, max_block_size);
+    }
+}
+
+PartitionedConvolver::PartitionedConvolver(const PartitionedConvolver& other) = default;
+PartitionedConvolver::PartitionedConvolver(PartitionedConvolver&& other) noexcept = default;
+PartitionedConvolver& PartitionedConvolver::operator=(const PartitionedConvolver& other) = default;
+PartitionedConvolver& PartitionedConvolver::operator=(PartitionedConvolver&& other) noexcept = default;
+PartitionedConvolver::~PartitionedConvolver() = default;
+
+void PartitionedConvolver::processBlock() noexcept {
+    std::fill(m_output.begin(), m_output.end(), 0.0);
+
+    for (auto& stage : m_stages) {
+        stage.push(m_input.data(), m_block_size);
+
+        ///<    larger stages compute less often, their last block is read at the current position
+        const double* y = stage.getOutput() + stage.getFill();
+        for (size_t n = 0; n < m_block_size; ++n) {
+            m_output[n] += y[n];
+        }
+    }
+}
+
+std::expected <PartitionedConvolver, FIRError> PartitionedConvolver::create(const FIR& fir, size_t block_size) {
+    return create(fir, block_size, block_size);
+}
+
+std::expected <PartitionedConvolver, FIRError> PartitionedConvolver::create(const FIR& fir, size_t block_size, size_t max_block_size) {
+    if (fir.getSize() == 0) {
+        return std::unexpected(FIRError::InvalidSize);
+    }
+
+    if (!isValidBlockSize(block_size) || !isValidBlockSize(max_block_size)) {
+        return std::unexpected(FIRError::InvalidParameterValue);
+    }
+
+    if (max_block_size < block_size) {
+        return std::unexpected(FIRError::InvalidParameterOrder);
+    }
+
+    return PartitionedConvolver(fir.getCoefficients(), block_size, max_block_size);
+}
+
+template <class Sample>
+std::expected <void, FIRError> PartitionedConvolver::processSamples(std::span <const Sample> input, std::span <Sample> output) {
+    const size_t N = input.size();
+
+    if (output.size() != N) {
+        return std::unexpected(FIRError::MismatchedSize);
+    }
+
+    detail::ScopedMeasurement measurement(m_counters, N, N * m_size);
+    size_t position = 0;
+
+    ///<    input is copied out before output is written, so both may be the same vector
+    while (position < N) {
+        const size_t count = std::min(N - position, m_block_size - m_fill);
+
+        std::copy(input.begin() + position, input.begin() + position + count, m_input.begin() + m_fill);
+        std::transform(m_output.begin() + m_fill, m_output.begin() + m_fill + count, output.begin() + position,
+                       [](double y) { return static_cast <Sample> (y); });
+
+        m_fill += count;
+        position += count;
+
+        if (m_fill == m_block_size) {
+            processBlock();
+            m_fill = 0;
+        }
+    }
+
+    return {};
+}
+
+std::expected <void, FIRError> PartitionedConvolver::process(const std::vector <double>& input, std::vector <double>& output) {
+    return processSamples <double> (input, output);
+}
+
+std::expected <void, FIRError> PartitionedConvolver::processInPlace(std::vector <double>& signal) {
+    return process(signal, signal);
+}
+
+std::expected <void, FIRError> PartitionedConvolver::process(const std::vector <float>& input, std::vector <float>& output) {
+    return processSamples <float> (input, output);
+}
+
+std::expected <void, FIRError> PartitionedConvolver::processInPlace(std::vector <float>& signal) {
+    return process(signal, signal);
+}
+
+std::expected <void, FIRError> PartitionedConvolver::process(std::span <const double> input, std::span <double> output) {
+    return processSamples(input, output);
+}
+
+std::expected <void, FIRError> PartitionedConvolver::process(std::span <const float> input, std::span <float> output) {
+    return processSamples(input, output);
+}
+
+void PartitionedConvolver::reset() noexcept {
+    for (auto& stage : m_stages) {
+        stage.reset();
+    }
+    std::fill(m_input.begin(), m_input.end(), 0.0);
+    std::fill(m_output.begin(), m_output.end(), 0.0);
+    m_fill = 0;
+}
+
+FilterStats PartitionedConvolver::getStats() const noexcept {
+    return m_counters.snapshot();
+}
+
+void PartitionedConvolver::resetStats() noexcept {
+    m_counters.reset();
+}
+
+size_t PartitionedConvolver::getLatency() const noexcept {
+    return m_block_size;
+}
+
+size_t PartitionedConvolver::getBlockSize() const noexcept {
+    return m_block_size;
+}
+
+size_t PartitionedConvolver::getSize() const noexcept {
+    return m_size;
+}
+
+size_t PartitionedConvolver::getPartitionCount() const noexcept {
+    size_t count = 0;
+    for (const auto& stage : m_stages) {
+        count += stage.getPartitionCount();
+    }
+    return count;
+}
+
+}
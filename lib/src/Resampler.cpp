@@ -0,0 +1,211 @@
+#include "Resampler.hpp"
+#include "WindowLowpass.hpp"
+#include "detail/Polyphase.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace oh::fir {
+
+namespace {
+
+///<    minimal number of input samples per chunk, the history is moved once per chunk
+constexpr size_t MIN_CHUNK_SIZE = 256;
+
+/// @brief transition width of a window design times its size
+double getTransitionFactor(wnd::WindowType w_type) {
+    switch (w_type) {
+        case wnd::WindowType::Rectangular:
+            return 0.9;
+        case wnd::WindowType::Hanning:
+            return 3.1;
+        case wnd::WindowType::Hamming:
+            return 3.3;
+        case wnd::WindowType::Blackman:
+        default:
+            return 5.5;
+    }
+}
+
+///<    consecutive outputs use different sub-filters, so each output is one dot product, four sums hide the add latency
+template <class Sample, class Accumulator>
+Accumulator dot(const Sample* x, const Accumulator* h, size_t taps) noexcept {
+    Accumulator s0 = 0;
+    Accumulator s1 = 0;
+    Accumulator s2 = 0;
+    Accumulator s3 = 0;
+    size_t j = 0;
+
+    for (; j + 4 <= taps; j += 4) {
+        s0 += h[j] * static_cast <Accumulator> (x[j]);
+        s1 += h[j + 1] * static_cast <Accumulator> (x[j + 1]);
+        s2 += h[j + 2] * static_cast <Accumulator> (x[j + 2]);
+        s3 += h[j + 3] * static_cast <Accumulator> (x[j + 3]);
+    }
+    for (; j < taps; ++j) {
+        s0 += h[j] * static_cast <Accumulator> (x[j]);
+    }
+
+    return (s0 + s1) + (s2 + s3);
+}
+
+}
+
+template <class Sample, class Accumulator>
+BasicResampler <Sample, Accumulator>::BasicResampler(const std::vector <double>& coefficients, size_t up, size_t down)
+: m_up(up), m_down(down), m_size(coefficients.size()), m_phase_length(detail::getPhaseLength(coefficients.size(), up)), m_position(0) {
+    const size_t M = coefficients.size();
+    const size_t T = m_phase_length;
+
+    ///<    same sub-filters as the Interpolator, with the gain lost by interpolation restored
+    m_phases.assign(up * T, Accumulator(0));
+    for (size_t q = 0; q < up; ++q) {
+        for (size_t j = 0; j < T; ++j) {
+            const size_t k = (T - 1 - j) * up + q;
+            if (k < M) {
+                m_phases[q * T + j] = static_cast <Accumulator> (up * coefficients[k]);
+            }
+        }
+    }
+
+    m_chunk_size = std::max(T, MIN_CHUNK_SIZE);
+    m_buffer.assign(T - 1 + m_chunk_size, Sample(0));
+}
+
+template <class Sample, class Accumulator>
+std::expected <BasicResampler <Sample, Accumulator>, FIRError> BasicResampler <Sample, Accumulator>::create(size_t up, size_t down, double transition,
+                                                                                                         wnd::WindowType w_type) {
+    if (up == 0 || down == 0) {
+        return std::unexpected(FIRError::InvalidParameterValue);
+    }
+
+    if (transition <= 0.0 || transition >= 0.5) {
+        return std::unexpected(FIRError::InvalidParameterValue);
+    }
+
+    const size_t divisor = std::gcd(up, down);
+    const double rate = static_cast <double> (std::max(up, down) / divisor);
+
+    ///<    on the interpolated rate the lower nyquist frequency is 0.5/rate, the cutoff sits in the middle of the transition band
+    const double fc = (0.5 - 0.5 * transition) / rate;
+    size_t size = static_cast <size_t> (std::ceil(getTransitionFactor(w_type) * rate / transition));
+    size = std::max <size_t> (size | 1, 3);
+
+    auto lp = WindowLowpass::create(fc, size, w_type);
+    if (!lp) {
+        return std::unexpected(lp.error());
+    }
+
+    return BasicResampler(lp -> getCoefficients(), up / divisor, down / divisor);
+}
+
+template <class Sample, class Accumulator>
+std::expected <BasicResampler <Sample, Accumulator>, FIRError> BasicResampler <Sample, Accumulator>::create(const FIR& fir, size_t up, size_t down) {
+    if (fir.getSize() == 0) {
+        return std::unexpected(FIRError::InvalidSize);
+    }
+
+    if (up == 0 || down == 0) {
+        return std::unexpected(FIRError::InvalidParameterValue);
+    }
+
+    const size_t divisor = std::gcd(up, down);
+    const size_t rate = std::max(up, down) / divisor;
+
+    if (rate > 1 && !detail::isBandLimited(fir.getCoefficients(), 0.5 / rate)) {
+        return std::unexpected(FIRError::InvalidParameterValue);
+    }
+
+    return BasicResampler(fir.getCoefficients(), up / divisor, down / divisor);
+}
+
+template <class Sample, class Accumulator>
+size_t BasicResampler <Sample, Accumulator>::processChunk(Sample* output, size_t count) noexcept {
+    const size_t T = m_phase_length;
+    const size_t end = count * m_up;
+    size_t outputs = 0;
+
+    ///<    the output at position p needs input p/up (and the T-1 before it) and sub-filter p%up
+    for (; m_position < end; m_position += m_down) {
+        const size_t m = m_position / m_up;
+        const size_t q = m_position % m_up;
+        output[outputs++] = static_cast <Sample> (dot(m_buffer.data() + m, m_phases.data() + q * T, T));
+    }
+    m_position -= end;
+
+    ///<    the last T-1 samples become the history of the next chunk
+    std::copy(m_buffer.begin() + count, m_buffer.begin() + count + T - 1, m_buffer.begin());
+
+    return outputs;
+}
+
+template <class Sample, class Accumulator>
+size_t BasicResampler <Sample, Accumulator>::getOutputSize(size_t input_size) const noexcept {
+    const size_t end = input_size * m_up;
+    return (m_position < end) ? (end - m_position - 1) / m_down + 1 : 0;
+}
+
+template <class Sample, class Accumulator>
+std::expected <size_t, FIRError> BasicResampler <Sample, Accumulator>::process(std::span <const Sample> input, std::span <Sample> output) {
+    const size_t N = input.size();
+
+    if (output.size() < getOutputSize(N)) {
+        return std::unexpected(FIRError::MismatchedSize);
+    }
+
+    const size_t history = m_phase_length - 1;
+    size_t written = 0;
+
+    for (size_t offset = 0; offset < N; offset += m_chunk_size) {
+        const size_t count = std::min(m_chunk_size, N - offset);
+        std::copy(input.begin() + offset, input.begin() + offset + count, m_buffer.begin() + history);
+        written += processChunk(output.data() + written, count);
+    }
+
+    return written;
+}
+
+template <class Sample, class Accumulator>
+std::expected <std::vector <Sample>, FIRError> BasicResampler <Sample, Accumulator>::process(const std::vector <Sample>& input) {
+    std::vector <Sample> w(getOutputSize(input.size()));
+
+    if (auto r = process(std::span <const Sample> (input), std::span <Sample> (w)); !r) {
+        return std::unexpected(r.error());
+    }
+
+    return w;
+}
+
+template <class Sample, class Accumulator>
+void BasicResampler <Sample, Accumulator>::reset() noexcept {
+    std::fill(m_buffer.begin(), m_buffer.end(), Sample(0));
+    m_position = 0;
+}
+
+template <class Sample, class Accumulator>
+double BasicResampler <Sample, Accumulator>::getGroupDelay() const noexcept {
+    ///<    (size-1)/2 samples of the interpolated rate, down of which make one output sample
+    return (m_size - 1) / (2.0 * m_down);
+}
+
+template <class Sample, class Accumulator>
+size_t BasicResampler <Sample, Accumulator>::getUpFactor() const noexcept {
+    return m_up;
+}
+
+template <class Sample, class Accumulator>
+size_t BasicResampler <Sample, Accumulator>::getDownFactor() const noexcept {
+    return m_down;
+}
+
+template <class Sample, class Accumulator>
+size_t BasicResampler <Sample, Accumulator>::getSize() const noexcept {
+    return m_size;
+}
+
+template class BasicResampler <double, double>;
+template class BasicResampler <float, float>;
+template class BasicResampler <float, double>;
+
+}
@@ -0,0 +1,64 @@
+#include "SIMD.hpp"
+
+#include <atomic>
+
+namespace oh::fir {
+
+namespace {
+
+SIMDLevel detectSIMDLevel() noexcept {
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return SIMDLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return SIMDLevel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return SIMDLevel::SSE2;
+    }
+#endif
+    return SIMDLevel::Scalar;
+}
+
+std::atomic <SIMDLevel>& currentLevel() noexcept {
+    static std::atomic <SIMDLevel> level(getSupportedSIMDLevel());
+    return level;
+}
+
+}
+
+std::string toString(SIMDLevel level) {
+    switch (level) {
+        case SIMDLevel::Scalar:
+            return "Scalar";
+        case SIMDLevel::SSE2:
+            return "SSE2";
+        case SIMDLevel::AVX2:
+            return "AVX2";
+        case SIMDLevel::AVX512:
+            return "AVX512";
+        default:
+            return "Undefined";
+    }
+}
+
+SIMDLevel getSupportedSIMDLevel() noexcept {
+    static const SIMDLevel supported = detectSIMDLevel();
+    return supported;
+}
+
+SIMDLevel getSIMDLevel() noexcept {
+    return currentLevel().load(std::memory_order_relaxed);
+}
+
+std::expected <void, FIRError> setSIMDLevel(SIMDLevel level) {
+    if (static_cast <int> (level) > static_cast <int> (getSupportedSIMDLevel())) {
+        return std::unexpected(FIRError::InvalidParameterValue);
+    }
+    currentLevel().store(level, std::memory_order_relaxed);
+    return {};
+}
+
+}
@@ -0,0 +1,38 @@
+#include "SampleFormat.hpp"
+
+namespace oh::fir {
+
+std::string toString(SampleFormat format) {
+    switch (format) {
+        case SampleFormat::Int16:
+            return "Int16";
+        case SampleFormat::Int24:
+            return "Int24";
+        case SampleFormat::Int32:
+            return "Int32";
+        case SampleFormat::Float32:
+            return "Float32";
+        case SampleFormat::Float64:
+            return "Float64";
+        default:
+            return "Undefined";
+    }
+}
+
+size_t getSampleSize(SampleFormat format) noexcept {
+    switch (format) {
+        case SampleFormat::Int16:
+            return 2;
+        case SampleFormat::Int24:
+            return 3;
+        case SampleFormat::Int32:
+        case SampleFormat::Float32:
+            return 4;
+        case SampleFormat::Float64:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+}
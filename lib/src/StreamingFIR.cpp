@@ -0,0 +1,146 @@
+#include "StreamingFIR.hpp"
+#include "detail/OverlapSave.hpp"
+#include "detail/Kernels.hpp"
+
+#include <algorithm>
+
+namespace oh::fir {
+
+namespace {
+
+///<    approximate number of samples per chunk when the fft engine is used
+constexpr size_t FFT_CHUNK_SIZE = 4096;
+
+}
+
+template <class Sample, class Accumulator>
+BasicStreamingFIR <Sample, Accumulator>::BasicStreamingFIR(const FIR& fir)
+: m_reversed_coefficients(fir.getKernelCoefficients().begin(), fir.getKernelCoefficients().end()), m_symmetric(fir.isSymmetric()),
+  m_chunk_size(std::max <size_t> (fir.getCoefficients().size(), 512)) {
+    const std::vector <double>& coefficients = fir.getCoefficients();
+    const size_t M = coefficients.size();
+
+    ///<    a full chunk is the best case for the fft, if even that is not cheaper the engine is never used
+    if (detail::OverlapSave::isCheaper(M, std::max(M, FFT_CHUNK_SIZE), m_symmetric, SINGLE_PRECISION)) {
+        m_fft_engine = std::make_unique <detail::OverlapSave> (coefficients.data(), M, detail::OverlapSave::chooseFFTSize(M));
+        const size_t step = m_fft_engine -> getStep();
+        m_chunk_size = step * std::max <size_t> (1, FFT_CHUNK_SIZE / step);
+    }
+
+    m_buffer.assign(M - 1 + m_chunk_size, Sample(0));
+}
+
+template <class Sample, class Accumulator>
+BasicStreamingFIR <Sample, Accumulator>::BasicStreamingFIR(const BasicStreamingFIR& other)
+: m_reversed_coefficients(other.m_reversed_coefficients), m_buffer(other.m_buffer), m_symmetric(other.m_symmetric), m_chunk_size(other.m_chunk_size),
+  m_fft_engine(other.m_fft_engine ? std::make_unique <detail::OverlapSave> (*other.m_fft_engine) : nullptr), m_counters(other.m_counters) {}
+
+template <class Sample, class Accumulator>
+BasicStreamingFIR <Sample, Accumulator>::BasicStreamingFIR(BasicStreamingFIR&& other) noexcept = default;
+
+template <class Sample, class Accumulator>
+BasicStreamingFIR <Sample, Accumulator>& BasicStreamingFIR <Sample, Accumulator>::operator=(const BasicStreamingFIR& other) {
+    if (this != &other) {
+        BasicStreamingFIR copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+template <class Sample, class Accumulator>
+BasicStreamingFIR <Sample, Accumulator>& BasicStreamingFIR <Sample, Accumulator>::operator=(BasicStreamingFIR&& other) noexcept = default;
+
+template <class Sample, class Accumulator>
+BasicStreamingFIR <Sample, Accumulator>::~BasicStreamingFIR() = default;
+
+template <class Sample, class Accumulator>
+void BasicStreamingFIR <Sample, Accumulator>::processChunk(Sample* output, size_t count) noexcept {
+    const size_t M = m_reversed_coefficients.size();
+    const Accumulator* h = m_reversed_coefficients.data();
+    const Sample* x = m_buffer.data();
+
+    if (m_fft_engine && detail::OverlapSave::isCheaper(M, count, m_symmetric, SINGLE_PRECISION)) {
+        m_fft_engine -> process(x, count, output);
+    } else {
+        detail::convolveKernel(x, h, M, m_symmetric, output, count);
+    }
+
+    ///<    the last M-1 samples become the history of the next chunk
+    std::copy(m_buffer.begin() + count, m_buffer.begin() + count + M - 1, m_buffer.begin());
+}
+
+template <class Sample, class Accumulator>
+std::expected <BasicStreamingFIR <Sample, Accumulator>, FIRError> BasicStreamingFIR <Sample, Accumulator>::create(const FIR& fir) {
+    if (fir.getSize() == 0) {
+        return std::unexpected(FIRError::InvalidSize);
+    }
+
+    return BasicStreamingFIR(fir);
+}
+
+template <class Sample, class Accumulator>
+std::expected <void, FIRError> BasicStreamingFIR <Sample, Accumulator>::process(const std::vector <Sample>& input, std::vector <Sample>& output) {
+    return process(std::span <const Sample> (input), std::span <Sample> (output));
+}
+
+template <class Sample, class Accumulator>
+std::expected <void, FIRError> BasicStreamingFIR <Sample, Accumulator>::processInPlace(std::vector <Sample>& signal) {
+    return process(signal, signal);
+}
+
+template <class Sample, class Accumulator>
+std::expected <void, FIRError> BasicStreamingFIR <Sample, Accumulator>::process(std::span <const Sample> input, std::span <Sample> output) {
+    const size_t N = input.size();
+
+    if (output.size() != N) {
+        return std::unexpected(FIRError::MismatchedSize);
+    }
+
+    const size_t history = m_reversed_coefficients.size() - 1;
+    detail::ScopedMeasurement measurement(m_counters, N, N * (history + 1));
+
+    ///<    the chunk is copied into the buffer before any output is written, so input and output may alias
+    for (size_t offset = 0; offset < N; offset += m_chunk_size) {
+        const size_t count = std::min(m_chunk_size, N - offset);
+        std::copy(input.begin() + offset, input.begin() + offset + count, m_buffer.begin() + history);
+        processChunk(output.data() + offset, count);
+    }
+
+    return {};
+}
+
+template <class Sample, class Accumulator>
+std::expected <void, FIRError> BasicStreamingFIR <Sample, Accumulator>::processInPlace(std::span <Sample> signal) {
+    return process(signal, signal);
+}
+
+template <class Sample, class Accumulator>
+void BasicStreamingFIR <Sample, Accumulator>::reset() noexcept {
+    std::fill(m_buffer.begin(), m_buffer.end(), Sample(0));
+}
+
+template <class Sample, class Accumulator>
+FilterStats BasicStreamingFIR <Sample, Accumulator>::getStats() const noexcept {
+    return m_counters.snapshot();
+}
+
+template <class Sample, class Accumulator>
+void BasicStreamingFIR <Sample, Accumulator>::resetStats() noexcept {
+    m_counters.reset();
+}
+
+template <class Sample, class Accumulator>
+size_t BasicStreamingFIR <Sample, Accumulator>::getSize() const noexcept {
+    return m_reversed_coefficients.size();
+}
+
+template <class Sample, class Accumulator>
+ConvolutionMethod BasicStreamingFIR <Sample, Accumulator>::getMethod() const noexcept {
+    return m_fft_engine ? ConvolutionMethod::FFT : ConvolutionMethod::Direct;
+}
+
+template class BasicStreamingFIR <double, double>;
+template class BasicStreamingFIR <float, float>;
+template class BasicStreamingFIR <float, double>;
+
+}
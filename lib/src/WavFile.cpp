@@ -0,0 +1,383 @@
+#include "WavFile.hpp"
+#include "detail/SampleCodec.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <system_error>
+#include <utility>
+
+namespace oh::fir {
+
+namespace {
+
+///<    frames decoded or encoded per pass over the scratch bytes
+constexpr size_t WAV_CHUNK_FRAMES = 4096;
+
+constexpr uint16_t WAVE_FORMAT_PCM = 0x0001;
+constexpr uint16_t WAVE_FORMAT_IEEE_FLOAT = 0x0003;
+constexpr uint16_t WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+
+///<    largest header written by WavWriter: RIFF header, 40 byte extensible "fmt " chunk, "fact" chunk and "data" chunk header
+constexpr size_t WAV_MAX_HEADER_SIZE = 80;
+
+///<    speaker positions of the channel mask
+constexpr uint32_t SPEAKER_FRONT_CENTER = 0x4;
+constexpr uint16_t MAX_SPEAKERS = 18;
+
+///<    KSDATAFORMAT_SUBTYPE_PCM and _IEEE_FLOAT (xxxxxxxx-0000-0010-8000-00aa00389b71, little endian fields),
+///<    the first two bytes are replaced by the plain format tag
+constexpr std::array <uint8_t, 16> SUBFORMAT_GUID{0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71};
+
+uint16_t readU16(const std::byte* p) noexcept {
+    uint16_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+uint32_t readU32(const std::byte* p) noexcept {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+void writeU16(std::byte* p, uint16_t v) noexcept {
+    std::memcpy(p, &v, sizeof(v));
+}
+
+void writeU32(std::byte* p, uint32_t v) noexcept {
+    std::memcpy(p, &v, sizeof(v));
+}
+
+bool readExactly(std::FILE* file, std::byte* data, size_t size) noexcept {
+    return std::fread(data, 1, size, file) == size;
+}
+
+/// @brief maps the format tag and sample width of a "fmt " chunk to a SampleFormat
+std::expected <SampleFormat, FIRError> toSampleFormat(uint16_t tag, uint16_t bits) {
+    if (tag == WAVE_FORMAT_PCM) {
+        switch (bits) {
+            case 16:
+                return SampleFormat::Int16;
+            case 24:
+                return SampleFormat::Int24;
+            case 32:
+                return SampleFormat::Int32;
+        }
+    } else if (tag == WAVE_FORMAT_IEEE_FLOAT) {
+        switch (bits) {
+            case 32:
+                return SampleFormat::Float32;
+            case 64:
+                return SampleFormat::Float64;
+        }
+    }
+    return std::unexpected(FIRError::InvalidFileFormat);
+}
+
+bool isFloat(SampleFormat format) noexcept {
+    return format == SampleFormat::Float32 || format == SampleFormat::Float64;
+}
+
+/// @brief lays out the header of WavWriter with the sizes left at 0
+/// more than 16 bits or more than 2 channels need WAVE_FORMAT_EXTENSIBLE, ieee float needs a "fact" chunk
+/// the channel mask puts mono on the front center speaker and assigns the speakers in their standard order otherwise
+/// @param format layout of the samples
+/// @param header at least WAV_MAX_HEADER_SIZE bytes
+/// @param fact_offset set to the offset of the sample count of the "fact" chunk, 0 without one
+/// @return size of the header, the data follows
+size_t makeHeader(const WavFormat& format, std::byte* header, size_t& fact_offset) noexcept {
+    const uint16_t bytes = static_cast <uint16_t> (getSampleSize(format.sample_format));
+    const uint16_t tag = isFloat(format.sample_format) ? WAVE_FORMAT_IEEE_FLOAT : WAVE_FORMAT_PCM;
+    const bool extensible = 8 * bytes > 16 || format.channels > 2;
+    const uint32_t fmt_size = extensible ? 40 : (tag == WAVE_FORMAT_PCM ? 16 : 18);
+
+    std::memcpy(header, "RIFF", 4);
+    std::memcpy(header + 8, "WAVEfmt ", 8);
+    writeU32(header + 16, fmt_size);
+    writeU16(header + 20, extensible ? WAVE_FORMAT_EXTENSIBLE : tag);
+    writeU16(header + 22, format.channels);
+    writeU32(header + 24, format.sample_rate);
+    writeU32(header + 28, format.sample_rate * format.channels * bytes);
+    writeU16(header + 32, static_cast <uint16_t> (format.channels * bytes));
+    writeU16(header + 34, static_cast <uint16_t> (8 * bytes));
+
+    if (fmt_size > 16) {
+        ///<    cbSize, the size of the extension
+        writeU16(header + 36, static_cast <uint16_t> (fmt_size - 18));
+    }
+    if (extensible) {
+        uint32_t mask = 0;
+        if (format.channels == 1) {
+            mask = SPEAKER_FRONT_CENTER;
+        } else if (format.channels <= MAX_SPEAKERS) {
+            mask = (uint32_t(1) << format.channels) - 1;
+        }
+        writeU16(header + 38, static_cast <uint16_t> (8 * bytes));
+        writeU32(header + 40, mask);
+        std::memcpy(header + 44, SUBFORMAT_GUID.data(), SUBFORMAT_GUID.size());
+        writeU16(header + 44, tag);
+    }
+
+    size_t offset = 20 + fmt_size;
+    fact_offset = 0;
+    if (tag != WAVE_FORMAT_PCM) {
+        std::memcpy(header + offset, "fact", 4);
+        writeU32(header + offset + 4, 4);
+        fact_offset = offset + 8;
+        offset += 12;
+    }
+
+    std::memcpy(header + offset, "data", 4);
+    return offset + 8;
+}
+
+}
+
+WavReader::WavReader(std::FILE* file, const WavFormat& format, size_t frames)
+: m_file(file), m_format(format), m_frames(frames), m_bytes(WAV_CHUNK_FRAMES * format.channels * getSampleSize(format.sample_format)) {}
+
+std::expected <WavReader, FIRError> WavReader::open(const std::filesystem::path& path) {
+    std::error_code error;
+    const auto file_size = std::filesystem::file_size(path, error);
+    std::unique_ptr <std::FILE, detail::FileCloser> file(std::fopen(path.c_str(), "rb"));
+    if (error || !file) {
+        return std::unexpected(FIRError::FileError);
+    }
+
+    std::array <std::byte, 40> header;
+    if (!readExactly(file.get(), header.data(), 12) || std::memcmp(header.data(), "RIFF", 4) != 0 ||
+        std::memcmp(header.data() + 8, "WAVE", 4) != 0) {
+        return std::unexpected(FIRError::InvalidFileFormat);
+    }
+
+    std::expected <WavFormat, FIRError> format = std::unexpected(FIRError::InvalidFileFormat);
+    size_t offset = 12;
+
+    for (;;) {
+        if (!readExactly(file.get(), header.data(), 8)) {
+            ///<    no "data" chunk
+            return std::unexpected(FIRError::InvalidFileFormat);
+        }
+        const uint32_t chunk_size = readU32(header.data() + 4);
+        offset += 8;
+
+        if (std::memcmp(header.data(), "data", 4) == 0) {
+            if (!format) {
+                return std::unexpected(FIRError::InvalidFileFormat);
+            }
+            ///<    writers that cannot seek leave the size at 0xFFFFFFFF, files cut short end early: the file size decides then
+            const size_t available = file_size > offset ? static_cast <size_t> (file_size - offset) : 0;
+            const size_t data_size = std::min <size_t> (chunk_size, available);
+            const size_t frame = format->channels * getSampleSize(format->sample_format);
+            return WavReader(file.release(), *format, data_size / frame);
+        }
+
+        if (std::memcmp(header.data(), "fmt ", 4) == 0) {
+            if (chunk_size < 16) {
+                return std::unexpected(FIRError::InvalidFileFormat);
+            }
+            const size_t used = std::min <size_t> (chunk_size, header.size());
+            if (!readExactly(file.get(), header.data(), used)) {
+                return std::unexpected(FIRError::InvalidFileFormat);
+            }
+
+            uint16_t tag = readU16(header.data());
+            const uint16_t channels = readU16(header.data() + 2);
+            const uint32_t sample_rate = readU32(header.data() + 4);
+            const uint16_t block_align = readU16(header.data() + 12);
+            const uint16_t bits = readU16(header.data() + 14);
+            if (tag == WAVE_FORMAT_EXTENSIBLE) {
+                ///<    the sub format guid starts with the plain format tag
+                if (used < 40) {
+                    return std::unexpected(FIRError::InvalidFileFormat);
+                }
+                tag = readU16(header.data() + 24);
+            }
+
+            auto sample_format = toSampleFormat(tag, bits);
+            if (!sample_format || channels == 0 || sample_rate == 0 || block_align != channels * getSampleSize(*sample_format)) {
+                return std::unexpected(FIRError::InvalidFileFormat);
+            }
+            format = WavFormat{sample_rate, channels, *sample_format};
+
+            if (std::fseek(file.get(), static_cast <long> (chunk_size + (chunk_size & 1) - used), SEEK_CUR) != 0) {
+                return std::unexpected(FIRError::InvalidFileFormat);
+            }
+        } else if (std::fseek(file.get(), static_cast <long> (chunk_size + (chunk_size & 1)), SEEK_CUR) != 0) {
+            return std::unexpected(FIRError::InvalidFileFormat);
+        }
+        offset += chunk_size + (chunk_size & 1);
+    }
+}
+
+template <class Real>
+std::expected <size_t, FIRError> WavReader::readFrames(std::span <Real> output) {
+    const size_t channels = m_format.channels;
+    if (output.size() % channels != 0) {
+        return std::unexpected(FIRError::MismatchedSize);
+    }
+
+    const size_t frame = channels * getSampleSize(m_format.sample_format);
+    const size_t frames = std::min(output.size() / channels, m_frames - m_position);
+
+    for (size_t done = 0; done < frames; ) {
+        const size_t count = std::min(WAV_CHUNK_FRAMES, frames - done);
+        if (!readExactly(m_file.get(), m_bytes.data(), count * frame)) {
+            return std::unexpected(FIRError::FileError);
+        }
+        detail::decodeSamples(m_bytes.data(), m_format.sample_format, output.data() + done * channels, count * channels);
+        done += count;
+        m_position += count;
+    }
+
+    return frames;
+}
+
+std::expected <size_t, FIRError> WavReader::read(std::span <double> output) {
+    return readFrames(output);
+}
+
+std::expected <size_t, FIRError> WavReader::read(std::span <float> output) {
+    return readFrames(output);
+}
+
+const WavFormat& WavReader::getFormat() const noexcept {
+    return m_format;
+}
+
+size_t WavReader::getFrames() const noexcept {
+    return m_frames;
+}
+
+size_t WavReader::getPosition() const noexcept {
+    return m_position;
+}
+
+WavWriter::WavWriter(std::FILE* file, const WavFormat& format, size_t header_size, size_t fact_offset)
+: m_file(file), m_format(format), m_header_size(header_size), m_fact_offset(fact_offset),
+  m_bytes(WAV_CHUNK_FRAMES * format.channels * getSampleSize(format.sample_format)) {}
+
+WavWriter& WavWriter::operator=(WavWriter&& other) noexcept {
+    if (this != &other) {
+        if (m_file) {
+            (void)close();
+        }
+        m_file = std::move(other.m_file);
+        m_format = other.m_format;
+        m_header_size = other.m_header_size;
+        m_fact_offset = other.m_fact_offset;
+        m_frames = std::exchange(other.m_frames, 0);
+        m_bytes = std::move(other.m_bytes);
+    }
+    return *this;
+}
+
+WavWriter::~WavWriter() {
+    if (m_file) {
+        (void)close();
+    }
+}
+
+std::expected <WavWriter, FIRError> WavWriter::create(const std::filesystem::path& path, const WavFormat& format) {
+    if (format.channels == 0 || format.sample_rate == 0 || getSampleSize(format.sample_format) == 0) {
+        return std::unexpected(FIRError::InvalidParameterValue);
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return std::unexpected(FIRError::FileError);
+    }
+
+    ///<    the sizes are written as 0 and filled in by close()
+    std::array <std::byte, WAV_MAX_HEADER_SIZE> header{};
+    size_t fact_offset = 0;
+    const size_t header_size = makeHeader(format, header.data(), fact_offset);
+
+    WavWriter writer(file, format, header_size, fact_offset);
+    if (std::fwrite(header.data(), 1, header_size, file) != header_size) {
+        return std::unexpected(FIRError::FileError);
+    }
+    return writer;
+}
+
+template <class Real>
+std::expected <void, FIRError> WavWriter::writeFrames(std::span <const Real> input) {
+    const size_t channels = m_format.channels;
+    if (!m_file) {
+        return std::unexpected(FIRError::FileError);
+    }
+    if (input.size() % channels != 0) {
+        return std::unexpected(FIRError::MismatchedSize);
+    }
+
+    const size_t frame = channels * getSampleSize(m_format.sample_format);
+    const size_t frames = input.size() / channels;
+    ///<    the RIFF size field counts the data and the rest of the header in 32 bits
+    if ((m_frames + frames) * frame > std::numeric_limits <uint32_t>::max() - m_header_size) {
+        return std::unexpected(FIRError::InvalidSize);
+    }
+
+    for (size_t done = 0; done < frames; ) {
+        const size_t count = std::min(WAV_CHUNK_FRAMES, frames - done);
+        detail::encodeSamples(input.data() + done * channels, m_format.sample_format, m_bytes.data(), count * channels);
+        if (std::fwrite(m_bytes.data(), frame, count, m_file.get()) != count) {
+            return std::unexpected(FIRError::FileError);
+        }
+        done += count;
+        m_frames += count;
+    }
+
+    return {};
+}
+
+std::expected <void, FIRError> WavWriter::write(std::span <const double> input) {
+    return writeFrames(input);
+}
+
+std::expected <void, FIRError> WavWriter::write(std::span <const float> input) {
+    return writeFrames(input);
+}
+
+std::expected <void, FIRError> WavWriter::close() {
+    if (!m_file) {
+        return std::unexpected(FIRError::FileError);
+    }
+
+    std::FILE* file = m_file.release();
+    const size_t data_size = m_frames * m_format.channels * getSampleSize(m_format.sample_format);
+    bool ok = true;
+
+    ///<    chunks are padded to an even size
+    if (data_size & 1) {
+        const std::byte pad{0};
+        ok = std::fwrite(&pad, 1, 1, file) == 1;
+    }
+
+    std::array <std::byte, 4> size;
+    writeU32(size.data(), static_cast <uint32_t> (m_header_size - 8 + data_size + (data_size & 1)));
+    ok = ok && std::fseek(file, 4, SEEK_SET) == 0 && std::fwrite(size.data(), 1, 4, file) == 4;
+    if (m_fact_offset != 0) {
+        writeU32(size.data(), static_cast <uint32_t> (m_frames));
+        ok = ok && std::fseek(file, static_cast <long> (m_fact_offset), SEEK_SET) == 0 && std::fwrite(size.data(), 1, 4, file) == 4;
+    }
+    writeU32(size.data(), static_cast <uint32_t> (data_size));
+    ok = ok && std::fseek(file, static_cast <long> (m_header_size - 4), SEEK_SET) == 0 && std::fwrite(size.data(), 1, 4, file) == 4;
+
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) {
+        return std::unexpected(FIRError::FileError);
+    }
+    return {};
+}
+
+const WavFormat& WavWriter::getFormat() const noexcept {
+    return m_format;
+}
+
+size_t WavWriter::getFrames() const noexcept {
+    return m_frames;
+}
+
+}
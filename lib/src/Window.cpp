@@ -1,4 +1,5 @@
 #include "Window.hpp"
+#include "detail/WindowTables.hpp"
 
 namespace oh::wnd{
 
@@ -30,72 +31,28 @@ std::string toString(WindowError win_error) {
     }
 }
 
-Window::Window(size_t size) : m_type(WindowType::Rectangular), m_coefficients(size, 0.0) {}
+Window::Window(size_t size) : m_type(WindowType::Rectangular), m_size(size) {}
 
-Window::Window(WindowType w_type, size_t size) : m_type(w_type), m_coefficients(size, 0.0) {}
+Window::Window(WindowType w_type, size_t size) : m_type(w_type), m_size(size) {}
         
 std::expected <void, WindowError> Window::calculateCoefficients() {
-    const size_t N = m_coefficients.size();
-    std::vector <double> coefficients(N, 1.0);
-
-    switch (m_type) {
-        case WindowType::Rectangular: {
-            if(auto w = setCoefficients(coefficients); !w) {
-                return std::unexpected(w.error());
-            } else {
-                return {};
-            }
-        }
-        case WindowType::Hamming: {
-            const double a = 0.54;
-            const double b = 0.46;
-            for (size_t n = 0; n < N; n++) {
-                coefficients[n] = a - b * std::cos(2.0 * std::numbers::pi * n / (N - 1));
-            }
-            if(auto w = setCoefficients(coefficients); !w) {
-                return std::unexpected(w.error());
-            } else {
-                return {};
-            }
-        }
-        case WindowType::Hanning: {
-            for (size_t n = 0; n < N; n++) {
-                coefficients[n] = 0.5 * (1.0 - std::cos(2.0 * std::numbers::pi * n / (N - 1)));
-            }
-            if(auto w = setCoefficients(coefficients); !w) {
-                return std::unexpected(w.error());
-            } else {
-                return {};
-            }
-        }
-        case WindowType::Blackman: {
-            const double a = 0.42;
-            const double b = 0.50;
-            const double c = 0.08;
-            const double denominator = N - 1;
-            for (size_t n = 0; n < N; ++n) {
-                const double x = 2.0 * std::numbers::pi * n / denominator;
-                coefficients[n] = a - b * std::cos(x) + c * std::cos(2.0 * x);
-            }
-            if(auto w = setCoefficients(coefficients); !w) {
-                return std::unexpected(w.error());
-            } else {
-                return {};
-            }
-        }
-        default: {
-            return std::unexpected(WindowError::InvalidType);
-        }
+    auto table = detail::getWindowTable(m_type, m_size);
+
+    if (!table) {
+        return std::unexpected(table.error());
     }
+
+    m_coefficients = std::move(*table);
+    return {};
 }
 
 const size_t Window::getSize() const noexcept{
-    return m_coefficients.size();
+    return m_size;
 }
 
 std::expected <void, WindowError> Window::setCoefficients(const std::vector <double>& coefficients) {
-    if(coefficients.size() == m_coefficients.size()) {
-        m_coefficients = coefficients;
+    if(coefficients.size() == m_size) {
+        m_coefficients = std::make_shared <const std::vector <double>> (coefficients);
         return {};
     } else {
         return std::unexpected(WindowError::MismatchedSize);
@@ -111,7 +68,7 @@ std::expected <void, WindowError> Window::checkSize(size_t size) {
 }
 
 const std::vector <double>& Window::getCoefficients() const {
-    return m_coefficients;
+    return *m_coefficients;
 }
 
 std::expected <void, WindowError> Window::setWindowType(WindowType type) {
@@ -152,11 +109,12 @@ std::expected <Window, WindowError> Window::create(WindowType w_type, size_t siz
 }
 
 std::expected <std::vector <double>, WindowError> Window::apply(const std::vector <double>& signal) const{
+    const std::vector <double>& coefficients = *m_coefficients;
     const size_t signal_size = signal.size();
-    if (signal_size == m_coefficients.size()) {
+    if (signal_size == m_size) {
         std::vector <double> v(signal.size());
         for(size_t n = 0; n < signal_size; ++n) {
-            v[n] = signal[n] * m_coefficients[n]; 
+            v[n] = signal[n] * coefficients[n]; 
         }
         return v;
     } else {
@@ -165,11 +123,12 @@ std::expected <std::vector <double>, WindowError> Window::apply(const std::vecto
 }
 
 std::expected <void, WindowError> Window::applyInPlace(std::vector <double>& signal) const{
+    const std::vector <double>& coefficients = *m_coefficients;
     const size_t signal_size = signal.size();
     size_t iterator = 0;
-    if (signal_size == m_coefficients.size()) {
+    if (signal_size == m_size) {
         for(auto &w : signal) {
-            w *= m_coefficients[iterator];
+            w *= coefficients[iterator];
             iterator++;
         }
         return {};
@@ -178,6 +137,33 @@ std::expected <void, WindowError> Window::applyInPlace(std::vector <double>& sig
     }
 }
 
+std::expected <std::vector <float>, WindowError> Window::apply(const std::vector <float>& signal) const{
+    const std::vector <double>& coefficients = *m_coefficients;
+    const size_t signal_size = signal.size();
+    if (signal_size == m_size) {
+        std::vector <float> v(signal.size());
+        for(size_t n = 0; n < signal_size; ++n) {
+            v[n] = static_cast <float> (signal[n] * coefficients[n]);
+        }
+        return v;
+    } else {
+        return std::unexpected(WindowError::MismatchedSize);
+    }
+}
+
+std::expected <void, WindowError> Window::applyInPlace(std::vector <float>& signal) const{
+    const std::vector <double>& coefficients = *m_coefficients;
+    const size_t signal_size = signal.size();
+    if (signal_size == m_size) {
+        for(size_t n = 0; n < signal_size; ++n) {
+            signal[n] = static_cast <float> (signal[n] * coefficients[n]);
+        }
+        return {};
+    } else {
+        return std::unexpected(WindowError::MismatchedSize);
+    }
+}
+
 const WindowType Window::getType() const noexcept{
     return m_type;
 }
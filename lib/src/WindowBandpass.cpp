@@ -89,4 +89,8 @@ std::expected <WindowBandpass, FIRError> WindowBandpass::create(double fc_low, d
 
 }
 
+std::vector <double> WindowBandpass::getDesignParameters() const {
+    return {m_fc_low, m_fc_high};
+}
+
 }
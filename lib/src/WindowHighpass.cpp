@@ -80,7 +80,8 @@ std::expected <WindowHighpass, FIRError> WindowHighpass::create(double fc, size_
 
 }
 
+std::vector <double> WindowHighpass::getDesignParameters() const {
+    return {m_fc};
+}
 
-
-
-}
\ No newline at end of file
+}
@@ -76,4 +76,8 @@ std::expected <WindowLowpass, FIRError> WindowLowpass::create(double fc, size_t
 
 }
 
+std::vector <double> WindowLowpass::getDesignParameters() const {
+    return {m_fc};
+}
+
 }
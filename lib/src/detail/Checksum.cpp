@@ -0,0 +1,52 @@
+#include "detail/Checksum.hpp"
+
+#include <array>
+
+namespace oh::fir::detail {
+
+namespace {
+
+///<    slicing-by-4 tables: table[0] is the classic byte table, table[k] advances a byte k more positions,
+///<    so four bytes are folded with four lookups and no dependency between them
+
+constexpr uint32_t CRC32_POLYNOMIAL = 0xEDB88320u;
+
+constexpr std::array <std::array <uint32_t, 256>, 4> makeTables() {
+    std::array <std::array <uint32_t, 256>, 4> table{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k) {
+            c = (c & 1) ? (c >> 1) ^ CRC32_POLYNOMIAL : c >> 1;
+        }
+        table[0][i] = c;
+    }
+    for (size_t t = 1; t < 4; ++t) {
+        for (uint32_t i = 0; i < 256; ++i) {
+            table[t][i] = (table[t - 1][i] >> 8) ^ table[0][table[t - 1][i] & 0xFF];
+        }
+    }
+    return table;
+}
+
+constexpr auto CRC32_TABLES = makeTables();
+
+}
+
+uint32_t crc32(const std::byte* data, size_t size, uint32_t crc) noexcept {
+    uint32_t c = ~crc;
+    size_t i = 0;
+
+    for (; i + 4 <= size; i += 4) {
+        c ^= static_cast <uint32_t> (data[i]) | (static_cast <uint32_t> (data[i + 1]) << 8) |
+             (static_cast <uint32_t> (data[i + 2]) << 16) | (static_cast <uint32_t> (data[i + 3]) << 24);
+        c = CRC32_TABLES[3][c & 0xFF] ^ CRC32_TABLES[2][(c >> 8) & 0xFF] ^
+            CRC32_TABLES[1][(c >> 16) & 0xFF] ^ CRC32_TABLES[0][c >> 24];
+    }
+    for (; i < size; ++i) {
+        c = CRC32_TABLES[0][(c ^ static_cast <uint32_t> (data[i])) & 0xFF] ^ (c >> 8);
+    }
+
+    return ~c;
+}
+
+}
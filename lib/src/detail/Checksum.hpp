@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+///<    internal header, not part of the public interface
+
+namespace oh::fir::detail {
+
+/// @brief crc-32 (ieee 802.3, the one of zip and png) of a byte range
+/// @param data bytes
+/// @param size number of bytes
+/// @param crc result of the previous range when a buffer is checked in pieces, 0 for the first
+/// @return checksum
+uint32_t crc32(const std::byte* data, size_t size, uint32_t crc = 0) noexcept;
+
+}
@@ -0,0 +1,182 @@
+#include "detail/FFT.hpp"
+
+#include <cmath>
+#include <numbers>
+#include <utility>
+
+namespace oh::fir::detail {
+
+size_t nextPowerOfTwo(size_t n) noexcept {
+    size_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+FFT::FFT(size_t size) : m_size(size), m_twiddles(size / 2), m_bit_reverse(size, 0) {
+    for (size_t k = 0; k < size / 2; ++k) {
+        const double angle = -2.0 * std::numbers::pi * k / size;
+        m_twiddles[k] = {std::cos(angle), std::sin(angle)};
+    }
+
+    size_t bits = 0;
+    while ((size_t(1) << bits) < size) {
+        ++bits;
+    }
+
+    for (size_t i = 0; i < size; ++i) {
+        size_t r = 0;
+        for (size_t b = 0; b < bits; ++b) {
+            r |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        m_bit_reverse[i] = r;
+    }
+}
+
+void FFT::transform(std::complex <double>* data, bool inverse) const noexcept {
+    const size_t n = m_size;
+
+    for (size_t i = 0; i < n; ++i) {
+        const size_t r = m_bit_reverse[i];
+        if (i < r) {
+            std::swap(data[i], data[r]);
+        }
+    }
+
+    for (size_t length = 2; length <= n; length <<= 1) {
+        const size_t half = length / 2;
+        const size_t step = n / length;
+
+        for (size_t start = 0; start < n; start += length) {
+            for (size_t j = 0; j < half; ++j) {
+                const std::complex <double> w = inverse ? std::conj(m_twiddles[j * step]) : m_twiddles[j * step];
+                const std::complex <double> a = data[start + j];
+                const std::complex <double> b = data[start + j + half] * w;
+                data[start + j] = a + b;
+                data[start + j + half] = a - b;
+            }
+        }
+    }
+}
+
+void FFT::forward(std::complex <double>* data) const noexcept {
+    transform(data, false);
+}
+
+void FFT::inverse(std::complex <double>* data) const noexcept {
+    transform(data, true);
+}
+
+size_t FFT::getSize() const noexcept {
+    return m_size;
+}
+
+RealFFT::RealFFT(size_t size) : m_size(size), m_half(size / 2), m_twiddles(size / 2 + 1) {
+    for (size_t k = 0; k <= size / 2; ++k) {
+        const double angle = -2.0 * std::numbers::pi * k / size;
+        m_twiddles[k] = {std::cos(angle), std::sin(angle)};
+    }
+}
+
+void RealFFT::forward(const double* input, std::complex <double>* output, std::complex <double>* scratch) const noexcept {
+    const size_t h = m_size / 2;
+
+    ///<    even samples go to the real part, odd samples to the imaginary part
+    for (size_t n = 0; n < h; ++n) {
+        scratch[n] = {input[2 * n], input[2 * n + 1]};
+    }
+
+    m_half.forward(scratch);
+
+    for (size_t k = 0; k <= h; ++k) {
+        const std::complex <double> z = scratch[k % h];
+        const std::complex <double> z_mirror = std::conj(scratch[(h - k) % h]);
+        const std::complex <double> even = 0.5 * (z + z_mirror);
+        const std::complex <double> odd = std::complex <double> (0.0, -0.5) * (z - z_mirror);
+        output[k] = even + m_twiddles[k] * odd;
+    }
+}
+
+void RealFFT::inverse(const std::complex <double>* input, double* output, std::complex <double>* scratch) const noexcept {
+    const size_t h = m_size / 2;
+
+    ///<    undo the split done in forward(), the factor 2 makes the result match an unscaled inverse of size n
+    for (size_t k = 0; k < h; ++k) {
+        const std::complex <double> x = input[k];
+        const std::complex <double> x_mirror = std::conj(input[h - k]);
+        const std::complex <double> even = x + x_mirror;
+        const std::complex <double> odd = (x - x_mirror) * std::conj(m_twiddles[k]);
+        scratch[k] = even + std::complex <double> (0.0, 1.0) * odd;
+    }
+
+    m_half.inverse(scratch);
+
+    for (size_t n = 0; n < h; ++n) {
+        output[2 * n] = scratch[n].real();
+        output[2 * n + 1] = scratch[n].imag();
+    }
+}
+
+size_t RealFFT::getSize() const noexcept {
+    return m_size;
+}
+
+Bluestein::Bluestein(size_t size) : m_size(size), m_fft(nextPowerOfTwo(2 * size - 1)), m_chirp(size) {
+    const size_t L = m_fft.getSize();
+
+    ///<    k^2 is reduced modulo 2*size first, the angle stays small and exact for large k
+    for (size_t k = 0; k < size; ++k) {
+        const size_t square = (k * k) % (2 * size);
+        const double angle = -std::numbers::pi * square / size;
+        m_chirp[k] = {std::cos(angle), std::sin(angle)};
+    }
+
+    m_filter.assign(L, {0.0, 0.0});
+    m_filter[0] = std::conj(m_chirp[0]);
+    for (size_t k = 1; k < size; ++k) {
+        m_filter[k] = std::conj(m_chirp[k]);
+        m_filter[L - k] = std::conj(m_chirp[k]);
+    }
+    m_fft.forward(m_filter.data());
+}
+
+void Bluestein::forward(std::complex <double>* data) const {
+    const size_t L = m_fft.getSize();
+
+    ///<    X[m] = chirp[m] * sum of (x[k]*chirp[k]) * conj(chirp[m-k]), as km = (k^2 + m^2 - (m-k)^2)/2
+    std::vector <std::complex <double>> work(L, {0.0, 0.0});
+    for (size_t k = 0; k < m_size; ++k) {
+        work[k] = data[k] * m_chirp[k];
+    }
+
+    m_fft.forward(work.data());
+    for (size_t k = 0; k < L; ++k) {
+        work[k] *= m_filter[k];
+    }
+    m_fft.inverse(work.data());
+
+    const double scale = 1.0 / L;
+    for (size_t m = 0; m < m_size; ++m) {
+        data[m] = work[m] * m_chirp[m] * scale;
+    }
+}
+
+void Bluestein::inverse(std::complex <double>* data) const {
+    ///<    the inverse transform is the conjugated forward transform of the conjugated input
+    for (size_t k = 0; k < m_size; ++k) {
+        data[k] = std::conj(data[k]);
+    }
+
+    forward(data);
+
+    for (size_t k = 0; k < m_size; ++k) {
+        data[k] = std::conj(data[k]);
+    }
+}
+
+size_t Bluestein::getSize() const noexcept {
+    return m_size;
+}
+
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <vector>
+#include <complex>
+#include <cstddef>
+
+///<    internal header, not part of the public interface
+
+namespace oh::fir::detail {
+
+/// @brief returns the smallest power of two not lower than n
+/// @param n value to round up
+/// @return power of two
+size_t nextPowerOfTwo(size_t n) noexcept;
+
+/// @brief iterative radix-2 complex fft with precomputed twiddles
+class FFT {
+
+    private:
+
+    size_t m_size;
+
+    /// @brief exp(-2*pi*i*k/size) for k < size/2
+    std::vector <std::complex <double>> m_twiddles;
+
+    /// @brief bit reversed index of every position
+    std::vector <size_t> m_bit_reverse;
+
+    void transform(std::complex <double>* data, bool inverse) const noexcept;
+
+    public:
+
+    /// @brief constructor
+    /// @param size size of the transform, must be a power of two
+    explicit FFT(size_t size);
+
+    /// @brief forward transform in place
+    /// @param data pointer to size complex values
+    void forward(std::complex <double>* data) const noexcept;
+
+    /// @brief inverse transform in place, not scaled by 1/size
+    /// @param data pointer to size complex values
+    void inverse(std::complex <double>* data) const noexcept;
+
+    size_t getSize() const noexcept;
+
+};
+
+/// @brief real input fft of size n computed with a complex fft of size n/2
+class RealFFT {
+
+    private:
+
+    size_t m_size;
+
+    FFT m_half;
+
+    /// @brief exp(-2*pi*i*k/size) for k <= size/2
+    std::vector <std::complex <double>> m_twiddles;
+
+    public:
+
+    /// @brief constructor
+    /// @param size size of the transform, must be a power of two, at least 4
+    explicit RealFFT(size_t size);
+
+    /// @brief forward transform
+    /// @param input size real samples
+    /// @param output size/2+1 complex bins
+    /// @param scratch size/2 complex values of scratch memory
+    void forward(const double* input, std::complex <double>* output, std::complex <double>* scratch) const noexcept;
+
+    /// @brief inverse transform, not scaled by 1/size
+    /// @param input size/2+1 complex bins of a real signal
+    /// @param output size real samples
+    /// @param scratch size/2 complex values of scratch memory
+    void inverse(const std::complex <double>* input, double* output, std::complex <double>* scratch) const noexcept;
+
+    size_t getSize() const noexcept;
+
+};
+
+/// @brief complex dft of any size, calculated with power of two ffts (bluestein's chirp-z algorithm),
+/// used where the size is fixed by the caller and cannot be rounded up, O(size log size)
+class Bluestein {
+
+    private:
+
+    size_t m_size;
+
+    /// @brief fft of at least 2*size-1 points, the chirp convolution is a circular convolution of that size
+    FFT m_fft;
+
+    /// @brief exp(-i*pi*k^2/size) for k < size
+    std::vector <std::complex <double>> m_chirp;
+
+    /// @brief fft of the conjugated chirp for offsets -(size-1)..size-1, wrapped around
+    std::vector <std::complex <double>> m_filter;
+
+    public:
+
+    /// @brief constructor
+    /// @param size size of the transform, nonzero
+    explicit Bluestein(size_t size);
+
+    /// @brief forward transform in place
+    /// @param data pointer to size complex values
+    void forward(std::complex <double>* data) const;
+
+    /// @brief inverse transform in place, not scaled by 1/size
+    /// @param data pointer to size complex values
+    void inverse(std::complex <double>* data) const;
+
+    size_t getSize() const noexcept;
+
+};
+
+}
@@ -0,0 +1,44 @@
+#include "detail/FilterTaps.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace oh::fir::detail {
+
+std::shared_ptr <const FilterTaps> makeFilterTaps(std::vector <double> coefficients) {
+    auto taps = std::make_shared <FilterTaps> ();
+    taps -> coefficients = std::move(coefficients);
+    const std::vector <double>& h = taps -> coefficients;
+
+    const size_t M = h.size();
+    double largest = 0.0;
+    for (auto v : h) {
+        largest = std::max(largest, std::abs(v));
+    }
+
+    ///<    windows are calculated with cos(), so mirrored coefficients can differ in the last bits
+    const double tolerance = 1e-12 * largest;
+    taps -> symmetric = true;
+    for (size_t n = 0; n < M / 2; ++n) {
+        if (std::abs(h[n] - h[M - 1 - n]) > tolerance) {
+            taps -> symmetric = false;
+            break;
+        }
+    }
+
+    ///<    the folded kernels read one tap of every pair, the mean keeps them as close to the given taps as the direct ones
+    AlignedVector <double>& reversed = taps -> reversed;
+    reversed.assign(h.rbegin(), h.rend());
+    if (taps -> symmetric) {
+        for (size_t n = 0; n < M / 2; ++n) {
+            const double mean = 0.5 * (reversed[n] + reversed[M - 1 - n]);
+            reversed[n] = mean;
+            reversed[M - 1 - n] = mean;
+        }
+    }
+    taps -> reversed_float.assign(reversed.begin(), reversed.end());
+
+    return taps;
+}
+
+}
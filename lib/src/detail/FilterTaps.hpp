@@ -0,0 +1,59 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <new>
+#include <cstddef>
+
+///<    internal header, not part of the public interface
+
+namespace oh::fir::detail {
+
+/// @brief alignment of the kernel copies of the taps, one cache line (and one avx-512 register)
+constexpr size_t TAP_ALIGNMENT = 64;
+
+/// @brief allocator handing out TAP_ALIGNMENT aligned storage
+template <class T>
+struct AlignedAllocator {
+
+    using value_type = T;
+
+    AlignedAllocator() noexcept = default;
+
+    template <class U>
+    AlignedAllocator(const AlignedAllocator <U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        return static_cast <T*> (::operator new(n * sizeof(T), std::align_val_t(TAP_ALIGNMENT)));
+    }
+
+    void deallocate(T* p, size_t) noexcept {
+        ::operator delete(p, std::align_val_t(TAP_ALIGNMENT));
+    }
+
+    template <class U>
+    bool operator==(const AlignedAllocator <U>&) const noexcept {
+        return true;
+    }
+
+};
+
+template <class T>
+using AlignedVector = std::vector <T, AlignedAllocator <T>>;
+
+/// @brief immutable taps of a filter with the copies the kernels read, made once and shared by every copy of the filter
+struct FilterTaps {
+    std::vector <double> coefficients;              ///<    taps as given, never changed
+    AlignedVector <double> reversed;                ///<    reversed taps, read by the double kernels (symmetric pairs made exactly equal)
+    AlignedVector <float> reversed_float;           ///<    reversed taps, read by the float kernels (symmetric pairs made exactly equal)
+    bool symmetric;                                 ///<    h[n] == h[size-1-n] for all n
+};
+
+/// @brief checks the symmetry of the taps and builds the reversed copies
+/// pairs that differ only by rounding (up to 1e-12 of the largest coefficient) count as symmetric,
+/// in the reversed copies they are replaced by their mean, so the folded kernels see exactly symmetric taps
+/// @param coefficients taps of the filter
+/// @return shared immutable taps
+std::shared_ptr <const FilterTaps> makeFilterTaps(std::vector <double> coefficients);
+
+}
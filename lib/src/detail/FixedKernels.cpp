@@ -0,0 +1,285 @@
+#include "detail/Kernels.hpp"
+#include "SIMD.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define EASYDSP_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+///<    fixed-point kernels: products are summed exactly in integers, which is associative, so the order in which
+///<    a simd kernel adds the products can not change a single bit of the result
+///<    the rounding and saturation are applied once per output, by the same scalar code on every instruction set
+///<    Q15 products fit in 31 bits, their 64 bit sums cannot overflow
+///<    Q31 products need 62 bits, their 64 bit sums would overflow as soon as sum |h| * max |x| passes 2, so every
+///<    coefficient is split into h = high * 2^16 + low with low in [0, 2^16), the products of both halves fit in 47 bits
+///<    and two 64 bit sums of them cannot overflow below 2^16 taps, finishQ31() joins them without loss
+
+namespace oh::fir::detail {
+
+namespace {
+
+/// @brief rounds a Q30 sum to Q15 and saturates it
+int16_t finishQ15(int64_t sum) noexcept {
+    const int64_t value = (sum + (int64_t(1) << 14)) >> 15;
+    return static_cast <int16_t> (std::clamp <int64_t> (value, std::numeric_limits <int16_t>::min(), std::numeric_limits <int16_t>::max()));
+}
+
+/// @brief rounds the sum high * 2^16 + low of the split Q31 products to Q31 and saturates it, without 128 bit integers
+int32_t finishQ31(int64_t high, int64_t low) noexcept {
+    ///<    sum = t * 2^16 + low % 2^16 with t = high + low / 2^16 (both rounded down), then t = q * 2^15 + r
+    const int64_t t = high + (low >> 16);
+    const int64_t q = t >> 15;
+    const int64_t r = t - q * (int64_t(1) << 15);
+    const int64_t value = q + (((r << 16) + (low & 0xFFFF) + (int64_t(1) << 30)) >> 31);
+    return static_cast <int32_t> (std::clamp <int64_t> (value, std::numeric_limits <int32_t>::min(), std::numeric_limits <int32_t>::max()));
+}
+
+int64_t highHalf(int32_t h) noexcept {
+    return h >> 16;
+}
+
+int64_t lowHalf(int32_t h) noexcept {
+    return h & 0xFFFF;
+}
+
+void scalarKernel(const int16_t* x, const int16_t* h, size_t taps, int16_t* y, size_t count) noexcept {
+    for (size_t n = 0; n < count; ++n) {
+        int64_t sum = 0;
+        for (size_t j = 0; j < taps; ++j) {
+            sum += int32_t(h[j]) * x[n + j];
+        }
+        y[n] = finishQ15(sum);
+    }
+}
+
+void scalarKernel(const int32_t* x, const int32_t* h, size_t taps, int32_t* y, size_t count) noexcept {
+    for (size_t n = 0; n < count; ++n) {
+        int64_t high = 0;
+        int64_t low = 0;
+        for (size_t j = 0; j < taps; ++j) {
+            high += highHalf(h[j]) * x[n + j];
+            low += lowHalf(h[j]) * x[n + j];
+        }
+        y[n] = finishQ31(high, low);
+    }
+}
+
+/// @brief two neighbouring Q15 coefficients as one 32 bit word (h[j] in the low half), the operand of a multiply-add
+int32_t loadPair(const int16_t* h) noexcept {
+    int32_t pair;
+    std::memcpy(&pair, h, sizeof(pair));
+    return pair;
+}
+
+}
+
+#ifdef EASYDSP_X86_KERNELS
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+namespace sse2 {
+
+/// @brief sign extends the four 32 bit lanes of v to 64 bits and adds them to lo (lanes 0, 1) and hi (lanes 2, 3)
+inline void widenAdd(__m128i v, __m128i& lo, __m128i& hi) noexcept {
+    const __m128i sign = _mm_srai_epi32(v, 31);
+    lo = _mm_add_epi64(lo, _mm_unpacklo_epi32(v, sign));
+    hi = _mm_add_epi64(hi, _mm_unpackhi_epi32(v, sign));
+}
+
+///<    eight outputs per step: interleaving x[n+j..] with x[n+j+1..] gives the pairs (x[k+j], x[k+j+1]) of every output k,
+///<    one pmaddwd with the broadcast pair (h[j], h[j+1]) then yields two products per output
+void q15Kernel(const int16_t* x, const int16_t* h, size_t taps, int16_t* y, size_t count) noexcept {
+    constexpr size_t W = 8;
+    const size_t pairs = taps / 2;
+    alignas(16) int64_t sums[W];
+    size_t n = 0;
+
+    for (; n + W <= count; n += W) {
+        __m128i a0 = _mm_setzero_si128();
+        __m128i a1 = _mm_setzero_si128();
+        __m128i a2 = _mm_setzero_si128();
+        __m128i a3 = _mm_setzero_si128();
+        const int16_t* xn = x + n;
+
+        for (size_t p = 0; p < pairs; ++p) {
+            const size_t j = 2 * p;
+            const __m128i c = _mm_set1_epi32(loadPair(h + j));
+            const __m128i v0 = _mm_loadu_si128(reinterpret_cast <const __m128i*> (xn + j));
+            const __m128i v1 = _mm_loadu_si128(reinterpret_cast <const __m128i*> (xn + j + 1));
+            widenAdd(_mm_madd_epi16(_mm_unpacklo_epi16(v0, v1), c), a0, a1);
+            widenAdd(_mm_madd_epi16(_mm_unpackhi_epi16(v0, v1), c), a2, a3);
+        }
+
+        if (taps % 2) {
+            const size_t j = taps - 1;
+            const __m128i c = _mm_set1_epi32(static_cast <uint16_t> (h[j]));
+            const __m128i v0 = _mm_loadu_si128(reinterpret_cast <const __m128i*> (xn + j));
+            const __m128i zero = _mm_setzero_si128();
+            widenAdd(_mm_madd_epi16(_mm_unpacklo_epi16(v0, zero), c), a0, a1);
+            widenAdd(_mm_madd_epi16(_mm_unpackhi_epi16(v0, zero), c), a2, a3);
+        }
+
+        _mm_store_si128(reinterpret_cast <__m128i*> (sums), a0);
+        _mm_store_si128(reinterpret_cast <__m128i*> (sums + 2), a1);
+        _mm_store_si128(reinterpret_cast <__m128i*> (sums + 4), a2);
+        _mm_store_si128(reinterpret_cast <__m128i*> (sums + 6), a3);
+        for (size_t k = 0; k < W; ++k) {
+            y[n + k] = finishQ15(sums[k]);
+        }
+    }
+
+    scalarKernel(x + n, h, taps, y + n, count - n);
+}
+
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC pop_options
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace avx2 {
+
+///<    sixteen outputs per step, the unpacks work inside 128 bit lanes, so the low products belong to
+///<    outputs 0-3 and 8-11 and the high ones to outputs 4-7 and 12-15
+void q15Kernel(const int16_t* x, const int16_t* h, size_t taps, int16_t* y, size_t count) noexcept {
+    constexpr size_t W = 16;
+    const size_t pairs = taps / 2;
+    alignas(32) int64_t sums[W];
+    size_t n = 0;
+
+    for (; n + W <= count; n += W) {
+        __m256i a0 = _mm256_setzero_si256();
+        __m256i a1 = _mm256_setzero_si256();
+        __m256i a2 = _mm256_setzero_si256();
+        __m256i a3 = _mm256_setzero_si256();
+        const int16_t* xn = x + n;
+
+        for (size_t p = 0; p <= pairs; ++p) {
+            const size_t j = 2 * p;
+            __m256i c;
+            __m256i v1;
+            const __m256i v0 = _mm256_loadu_si256(reinterpret_cast <const __m256i*> (xn + j));
+            if (p < pairs) {
+                c = _mm256_set1_epi32(loadPair(h + j));
+                v1 = _mm256_loadu_si256(reinterpret_cast <const __m256i*> (xn + j + 1));
+            } else if (taps % 2) {
+                c = _mm256_set1_epi32(static_cast <uint16_t> (h[j]));
+                v1 = _mm256_setzero_si256();
+            } else {
+                break;
+            }
+
+            const __m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(v0, v1), c);
+            const __m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(v0, v1), c);
+            a0 = _mm256_add_epi64(a0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(lo)));
+            a1 = _mm256_add_epi64(a1, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(hi)));
+            a2 = _mm256_add_epi64(a2, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(lo, 1)));
+            a3 = _mm256_add_epi64(a3, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(hi, 1)));
+        }
+
+        _mm256_store_si256(reinterpret_cast <__m256i*> (sums), a0);
+        _mm256_store_si256(reinterpret_cast <__m256i*> (sums + 4), a1);
+        _mm256_store_si256(reinterpret_cast <__m256i*> (sums + 8), a2);
+        _mm256_store_si256(reinterpret_cast <__m256i*> (sums + 12), a3);
+        for (size_t k = 0; k < W; ++k) {
+            y[n + k] = finishQ15(sums[k]);
+        }
+    }
+
+    scalarKernel(x + n, h, taps, y + n, count - n);
+}
+
+///<    Q31: vpmuldq multiplies the low 32 bits of every 64 bit lane, so the samples are sign extended to 64 bits first,
+///<    both halves of the split coefficient are multiplied with them
+void q31Kernel(const int32_t* x, const int32_t* h, size_t taps, int32_t* y, size_t count) noexcept {
+    constexpr size_t W = 8;
+    alignas(32) int64_t high[W];
+    alignas(32) int64_t low[W];
+    size_t n = 0;
+
+    for (; n + W <= count; n += W) {
+        __m256i h0 = _mm256_setzero_si256();
+        __m256i h1 = _mm256_setzero_si256();
+        __m256i l0 = _mm256_setzero_si256();
+        __m256i l1 = _mm256_setzero_si256();
+        const int32_t* xn = x + n;
+
+        for (size_t j = 0; j < taps; ++j) {
+            const __m256i ch = _mm256_set1_epi64x(highHalf(h[j]));
+            const __m256i cl = _mm256_set1_epi64x(lowHalf(h[j]));
+            const __m256i v0 = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast <const __m128i*> (xn + j)));
+            const __m256i v1 = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast <const __m128i*> (xn + j + 4)));
+            h0 = _mm256_add_epi64(h0, _mm256_mul_epi32(v0, ch));
+            h1 = _mm256_add_epi64(h1, _mm256_mul_epi32(v1, ch));
+            l0 = _mm256_add_epi64(l0, _mm256_mul_epi32(v0, cl));
+            l1 = _mm256_add_epi64(l1, _mm256_mul_epi32(v1, cl));
+        }
+
+        _mm256_store_si256(reinterpret_cast <__m256i*> (high), h0);
+        _mm256_store_si256(reinterpret_cast <__m256i*> (high + 4), h1);
+        _mm256_store_si256(reinterpret_cast <__m256i*> (low), l0);
+        _mm256_store_si256(reinterpret_cast <__m256i*> (low + 4), l1);
+        for (size_t k = 0; k < W; ++k) {
+            y[n + k] = finishQ31(high[k], low[k]);
+        }
+    }
+
+    scalarKernel(x + n, h, taps, y + n, count - n);
+}
+
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif
+
+///<    512 bit pmaddwd needs AVX-512BW, which the AVX512 level does not require, so it uses the AVX2 kernels
+///<    SSE2 has no signed 32x32->64 multiply, Q31 falls back to the scalar loop there
+
+void directKernel(const int16_t* x, const int16_t* h, size_t taps, int16_t* y, size_t count) noexcept {
+#ifdef EASYDSP_X86_KERNELS
+    switch (getSIMDLevel()) {
+        case SIMDLevel::AVX512:
+        case SIMDLevel::AVX2:
+            return avx2::q15Kernel(x, h, taps, y, count);
+        case SIMDLevel::SSE2:
+            return sse2::q15Kernel(x, h, taps, y, count);
+        default:
+            break;
+    }
+#endif
+    scalarKernel(x, h, taps, y, count);
+}
+
+void directKernel(const int32_t* x, const int32_t* h, size_t taps, int32_t* y, size_t count) noexcept {
+#ifdef EASYDSP_X86_KERNELS
+    switch (getSIMDLevel()) {
+        case SIMDLevel::AVX512:
+        case SIMDLevel::AVX2:
+            return avx2::q31Kernel(x, h, taps, y, count);
+        default:
+            break;
+    }
+#endif
+    scalarKernel(x, h, taps, y, count);
+}
+
+}
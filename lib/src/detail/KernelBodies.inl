@@ -0,0 +1,214 @@
+///<    internal file, included once per instruction set by Kernels.cpp, inside a namespace that defines the traits
+///<    a traits type V has: sample, coefficient (also the accumulator type), reg, width,
+///<    zero(), broadcast(const coefficient*), load(const sample*), fma(c, x, acc), store(sample*, reg)
+
+///<    every kernel walks the outputs in the outer loop and keeps four vectors of outputs in registers,
+///<    so each coefficient is broadcast once and every output is written once
+
+template <class V>
+void direct(const typename V::sample* x, const typename V::coefficient* h, size_t taps, typename V::sample* y, size_t count) noexcept {
+    using S = typename V::sample;
+    using A = typename V::coefficient;
+    constexpr size_t W = V::width;
+    size_t n = 0;
+
+    for (; n + 4 * W <= count; n += 4 * W) {
+        typename V::reg a0 = V::zero();
+        typename V::reg a1 = V::zero();
+        typename V::reg a2 = V::zero();
+        typename V::reg a3 = V::zero();
+        const S* xn = x + n;
+
+        for (size_t j = 0; j < taps; ++j) {
+            const typename V::reg c = V::broadcast(h + j);
+            a0 = V::fma(c, V::load(xn + j), a0);
+            a1 = V::fma(c, V::load(xn + j + W), a1);
+            a2 = V::fma(c, V::load(xn + j + 2 * W), a2);
+            a3 = V::fma(c, V::load(xn + j + 3 * W), a3);
+        }
+
+        V::store(y + n, a0);
+        V::store(y + n + W, a1);
+        V::store(y + n + 2 * W, a2);
+        V::store(y + n + 3 * W, a3);
+    }
+
+    for (; n + W <= count; n += W) {
+        typename V::reg a = V::zero();
+        for (size_t j = 0; j < taps; ++j) {
+            a = V::fma(V::broadcast(h + j), V::load(x + n + j), a);
+        }
+        V::store(y + n, a);
+    }
+
+    for (; n < count; ++n) {
+        A sum = 0;
+        for (size_t j = 0; j < taps; ++j) {
+            sum += h[j] * static_cast <A> (x[n + j]);
+        }
+        y[n] = static_cast <S> (sum);
+    }
+}
+
+///<    folded kernels for symmetric coefficients: h[j] == h[taps-1-j], mirrored samples are added before the multiply,
+///<    which halves the multiplies, the middle coefficient of an odd length is applied on its own
+
+template <class V>
+void folded(const typename V::sample* x, const typename V::coefficient* h, size_t taps, typename V::sample* y, size_t count) noexcept {
+    using S = typename V::sample;
+    using A = typename V::coefficient;
+    constexpr size_t W = V::width;
+    const size_t half = taps / 2;
+    const size_t last = taps - 1;
+    const A middle = (taps % 2) ? h[half] : A(0);
+    const typename V::reg m = V::broadcast(&middle);
+    size_t n = 0;
+
+    for (; n + 4 * W <= count; n += 4 * W) {
+        const S* xn = x + n;
+        typename V::reg a0 = V::fma(m, V::load(xn + half), V::zero());
+        typename V::reg a1 = V::fma(m, V::load(xn + half + W), V::zero());
+        typename V::reg a2 = V::fma(m, V::load(xn + half + 2 * W), V::zero());
+        typename V::reg a3 = V::fma(m, V::load(xn + half + 3 * W), V::zero());
+
+        for (size_t j = 0; j < half; ++j) {
+            const typename V::reg c = V::broadcast(h + j);
+            a0 = V::fma(c, V::add(V::load(xn + j), V::load(xn + last - j)), a0);
+            a1 = V::fma(c, V::add(V::load(xn + j + W), V::load(xn + last - j + W)), a1);
+            a2 = V::fma(c, V::add(V::load(xn + j + 2 * W), V::load(xn + last - j + 2 * W)), a2);
+            a3 = V::fma(c, V::add(V::load(xn + j + 3 * W), V::load(xn + last - j + 3 * W)), a3);
+        }
+
+        V::store(y + n, a0);
+        V::store(y + n + W, a1);
+        V::store(y + n + 2 * W, a2);
+        V::store(y + n + 3 * W, a3);
+    }
+
+    for (; n + W <= count; n += W) {
+        typename V::reg a = V::fma(m, V::load(x + n + half), V::zero());
+        for (size_t j = 0; j < half; ++j) {
+            a = V::fma(V::broadcast(h + j), V::add(V::load(x + n + j), V::load(x + n + last - j)), a);
+        }
+        V::store(y + n, a);
+    }
+
+    for (; n < count; ++n) {
+        A sum = middle * static_cast <A> (x[n + half]);
+        for (size_t j = 0; j < half; ++j) {
+            sum += h[j] * (static_cast <A> (x[n + j]) + static_cast <A> (x[n + last - j]));
+        }
+        y[n] = static_cast <S> (sum);
+    }
+}
+
+///<    multichannel kernels on interleaved frames: the lanes hold neighbouring channels of one frame,
+///<    so every coefficient is broadcast once for four vectors of channels, frame f reads frames f..f+taps-1
+
+template <class V>
+void multichannel(const typename V::sample* x, const typename V::coefficient* h, size_t taps, size_t channels,
+                  typename V::sample* y, size_t frames) noexcept {
+    using S = typename V::sample;
+    using A = typename V::coefficient;
+    constexpr size_t W = V::width;
+
+    for (size_t f = 0; f < frames; ++f) {
+        const S* xf = x + f * channels;
+        S* yf = y + f * channels;
+        size_t c = 0;
+
+        for (; c + 4 * W <= channels; c += 4 * W) {
+            typename V::reg a0 = V::zero();
+            typename V::reg a1 = V::zero();
+            typename V::reg a2 = V::zero();
+            typename V::reg a3 = V::zero();
+
+            for (size_t j = 0; j < taps; ++j) {
+                const typename V::reg k = V::broadcast(h + j);
+                const S* xj = xf + j * channels + c;
+                a0 = V::fma(k, V::load(xj), a0);
+                a1 = V::fma(k, V::load(xj + W), a1);
+                a2 = V::fma(k, V::load(xj + 2 * W), a2);
+                a3 = V::fma(k, V::load(xj + 3 * W), a3);
+            }
+
+            V::store(yf + c, a0);
+            V::store(yf + c + W, a1);
+            V::store(yf + c + 2 * W, a2);
+            V::store(yf + c + 3 * W, a3);
+        }
+
+        for (; c + W <= channels; c += W) {
+            typename V::reg a = V::zero();
+            for (size_t j = 0; j < taps; ++j) {
+                a = V::fma(V::broadcast(h + j), V::load(xf + j * channels + c), a);
+            }
+            V::store(yf + c, a);
+        }
+
+        for (; c < channels; ++c) {
+            A sum = 0;
+            for (size_t j = 0; j < taps; ++j) {
+                sum += h[j] * static_cast <A> (xf[j * channels + c]);
+            }
+            yf[c] = static_cast <S> (sum);
+        }
+    }
+}
+
+template <class V>
+void multichannelFolded(const typename V::sample* x, const typename V::coefficient* h, size_t taps, size_t channels,
+                        typename V::sample* y, size_t frames) noexcept {
+    using S = typename V::sample;
+    using A = typename V::coefficient;
+    constexpr size_t W = V::width;
+    const size_t half = taps / 2;
+    const size_t last = taps - 1;
+    const A middle = (taps % 2) ? h[half] : A(0);
+    const typename V::reg m = V::broadcast(&middle);
+
+    for (size_t f = 0; f < frames; ++f) {
+        const S* xf = x + f * channels;
+        S* yf = y + f * channels;
+        size_t c = 0;
+
+        for (; c + 4 * W <= channels; c += 4 * W) {
+            const S* xm = xf + half * channels + c;
+            typename V::reg a0 = V::fma(m, V::load(xm), V::zero());
+            typename V::reg a1 = V::fma(m, V::load(xm + W), V::zero());
+            typename V::reg a2 = V::fma(m, V::load(xm + 2 * W), V::zero());
+            typename V::reg a3 = V::fma(m, V::load(xm + 3 * W), V::zero());
+
+            for (size_t j = 0; j < half; ++j) {
+                const typename V::reg k = V::broadcast(h + j);
+                const S* xa = xf + j * channels + c;
+                const S* xb = xf + (last - j) * channels + c;
+                a0 = V::fma(k, V::add(V::load(xa), V::load(xb)), a0);
+                a1 = V::fma(k, V::add(V::load(xa + W), V::load(xb + W)), a1);
+                a2 = V::fma(k, V::add(V::load(xa + 2 * W), V::load(xb + 2 * W)), a2);
+                a3 = V::fma(k, V::add(V::load(xa + 3 * W), V::load(xb + 3 * W)), a3);
+            }
+
+            V::store(yf + c, a0);
+            V::store(yf + c + W, a1);
+            V::store(yf + c + 2 * W, a2);
+            V::store(yf + c + 3 * W, a3);
+        }
+
+        for (; c + W <= channels; c += W) {
+            typename V::reg a = V::fma(m, V::load(xf + half * channels + c), V::zero());
+            for (size_t j = 0; j < half; ++j) {
+                a = V::fma(V::broadcast(h + j), V::add(V::load(xf + j * channels + c), V::load(xf + (last - j) * channels + c)), a);
+            }
+            V::store(yf + c, a);
+        }
+
+        for (; c < channels; ++c) {
+            A sum = middle * static_cast <A> (xf[half * channels + c]);
+            for (size_t j = 0; j < half; ++j) {
+                sum += h[j] * (static_cast <A> (xf[j * channels + c]) + static_cast <A> (xf[(last - j) * channels + c]));
+            }
+            yf[c] = static_cast <S> (sum);
+        }
+    }
+}
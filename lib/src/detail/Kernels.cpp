@@ -0,0 +1,367 @@
+#include "detail/Kernels.hpp"
+#include "SIMD.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define EASYDSP_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+///<    the kernel bodies are written once (KernelBodies.inl) and compiled for every instruction set inside
+///<    a target region, so a generic build still contains the AVX2 and AVX-512 versions
+
+namespace oh::fir::detail {
+
+namespace scalar {
+
+template <class S, class A>
+struct Traits {
+    using sample = S;
+    using coefficient = A;
+    using reg = A;
+    static constexpr size_t width = 1;
+    static reg zero() noexcept { return A(0); }
+    static reg broadcast(const A* p) noexcept { return *p; }
+    static reg load(const S* p) noexcept { return static_cast <A> (*p); }
+    static reg fma(reg c, reg x, reg a) noexcept { return a + c * x; }
+    static reg add(reg a, reg b) noexcept { return a + b; }
+    static void store(S* p, reg v) noexcept { *p = static_cast <S> (v); }
+};
+
+using Double = Traits <double, double>;
+using Float = Traits <float, float>;
+using Mixed = Traits <float, double>;
+
+#include "detail/KernelBodies.inl"
+
+}
+
+#ifdef EASYDSP_X86_KERNELS
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+namespace sse2 {
+
+struct Double {
+    using sample = double;
+    using coefficient = double;
+    using reg = __m128d;
+    static constexpr size_t width = 2;
+    static reg zero() noexcept { return _mm_setzero_pd(); }
+    static reg broadcast(const double* p) noexcept { return _mm_set1_pd(*p); }
+    static reg load(const double* p) noexcept { return _mm_loadu_pd(p); }
+    static reg fma(reg c, reg x, reg a) noexcept { return _mm_add_pd(a, _mm_mul_pd(c, x)); }
+    static reg add(reg a, reg b) noexcept { return _mm_add_pd(a, b); }
+    static void store(double* p, reg v) noexcept { _mm_storeu_pd(p, v); }
+};
+
+struct Float {
+    using sample = float;
+    using coefficient = float;
+    using reg = __m128;
+    static constexpr size_t width = 4;
+    static reg zero() noexcept { return _mm_setzero_ps(); }
+    static reg broadcast(const float* p) noexcept { return _mm_set1_ps(*p); }
+    static reg load(const float* p) noexcept { return _mm_loadu_ps(p); }
+    static reg fma(reg c, reg x, reg a) noexcept { return _mm_add_ps(a, _mm_mul_ps(c, x)); }
+    static reg add(reg a, reg b) noexcept { return _mm_add_ps(a, b); }
+    static void store(float* p, reg v) noexcept { _mm_storeu_ps(p, v); }
+};
+
+struct Mixed {
+    using sample = float;
+    using coefficient = double;
+    using reg = __m128d;
+    static constexpr size_t width = 2;
+    static reg zero() noexcept { return _mm_setzero_pd(); }
+    static reg broadcast(const double* p) noexcept { return _mm_set1_pd(*p); }
+    static reg load(const float* p) noexcept { return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast <const __m128i*> (p)))); }
+    static reg fma(reg c, reg x, reg a) noexcept { return _mm_add_pd(a, _mm_mul_pd(c, x)); }
+    static reg add(reg a, reg b) noexcept { return _mm_add_pd(a, b); }
+    static void store(float* p, reg v) noexcept { _mm_storel_epi64(reinterpret_cast <__m128i*> (p), _mm_castps_si128(_mm_cvtpd_ps(v))); }
+};
+
+#include "detail/KernelBodies.inl"
+
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#pragma clang attribute push (__attribute__((target("avx2,fma"))), apply_to = function)
+#else
+#pragma GCC pop_options
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#endif
+
+namespace avx2 {
+
+struct Double {
+    using sample = double;
+    using coefficient = double;
+    using reg = __m256d;
+    static constexpr size_t width = 4;
+    static reg zero() noexcept { return _mm256_setzero_pd(); }
+    static reg broadcast(const double* p) noexcept { return _mm256_broadcast_sd(p); }
+    static reg load(const double* p) noexcept { return _mm256_loadu_pd(p); }
+    static reg fma(reg c, reg x, reg a) noexcept { return _mm256_fmadd_pd(c, x, a); }
+    static reg add(reg a, reg b) noexcept { return _mm256_add_pd(a, b); }
+    static void store(double* p, reg v) noexcept { _mm256_storeu_pd(p, v); }
+};
+
+struct Float {
+    using sample = float;
+    using coefficient = float;
+    using reg = __m256;
+    static constexpr size_t width = 8;
+    static reg zero() noexcept { return _mm256_setzero_ps(); }
+    static reg broadcast(const float* p) noexcept { return _mm256_broadcast_ss(p); }
+    static reg load(const float* p) noexcept { return _mm256_loadu_ps(p); }
+    static reg fma(reg c, reg x, reg a) noexcept { return _mm256_fmadd_ps(c, x, a); }
+    static reg add(reg a, reg b) noexcept { return _mm256_add_ps(a, b); }
+    static void store(float* p, reg v) noexcept { _mm256_storeu_ps(p, v); }
+};
+
+struct Mixed {
+    using sample = float;
+    using coefficient = double;
+    using reg = __m256d;
+    static constexpr size_t width = 4;
+    static reg zero() noexcept { return _mm256_setzero_pd(); }
+    static reg broadcast(const double* p) noexcept { return _mm256_broadcast_sd(p); }
+    static reg load(const float* p) noexcept { return _mm256_cvtps_pd(_mm_loadu_ps(p)); }
+    static reg fma(reg c, reg x, reg a) noexcept { return _mm256_fmadd_pd(c, x, a); }
+    static reg add(reg a, reg b) noexcept { return _mm256_add_pd(a, b); }
+    static void store(float* p, reg v) noexcept { _mm_storeu_ps(p, _mm256_cvtpd_ps(v)); }
+};
+
+#include "detail/KernelBodies.inl"
+
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#pragma clang attribute push (__attribute__((target("avx512f"))), apply_to = function)
+#else
+#pragma GCC pop_options
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#endif
+
+namespace avx512 {
+
+struct Double {
+    using sample = double;
+    using coefficient = double;
+    using reg = __m512d;
+    static constexpr size_t width = 8;
+    static reg zero() noexcept { return _mm512_setzero_pd(); }
+    static reg broadcast(const double* p) noexcept { return _mm512_set1_pd(*p); }
+    static reg load(const double* p) noexcept { return _mm512_loadu_pd(p); }
+    static reg fma(reg c, reg x, reg a) noexcept { return _mm512_fmadd_pd(c, x, a); }
+    static reg add(reg a, reg b) noexcept { return _mm512_add_pd(a, b); }
+    static void store(double* p, reg v) noexcept { _mm512_storeu_pd(p, v); }
+};
+
+struct Float {
+    using sample = float;
+    using coefficient = float;
+    using reg = __m512;
+    static constexpr size_t width = 16;
+    static reg zero() noexcept { return _mm512_setzero_ps(); }
+    static reg broadcast(const float* p) noexcept { return _mm512_set1_ps(*p); }
+    static reg load(const float* p) noexcept { return _mm512_loadu_ps(p); }
+    static reg fma(reg c, reg x, reg a) noexcept { return _mm512_fmadd_ps(c, x, a); }
+    static reg add(reg a, reg b) noexcept { return _mm512_add_ps(a, b); }
+    static void store(float* p, reg v) noexcept { _mm512_storeu_ps(p, v); }
+};
+
+struct Mixed {
+    using sample = float;
+    using coefficient = double;
+    using reg = __m512d;
+    static constexpr size_t width = 8;
+    static reg zero() noexcept { return _mm512_setzero_pd(); }
+    static reg broadcast(const double* p) noexcept { return _mm512_set1_pd(*p); }
+    static reg load(const float* p) noexcept { return _mm512_cvtps_pd(_mm256_loadu_ps(p)); }
+    static reg fma(reg c, reg x, reg a) noexcept { return _mm512_fmadd_pd(c, x, a); }
+    static reg add(reg a, reg b) noexcept { return _mm512_add_pd(a, b); }
+    static void store(float* p, reg v) noexcept { _mm256_storeu_ps(p, _mm512_cvtpd_ps(v)); }
+};
+
+#include "detail/KernelBodies.inl"
+
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif
+
+namespace {
+
+#ifdef EASYDSP_X86_KERNELS
+#define EASYDSP_DISPATCH(kernel, traits, ...)                           \
+    switch (getSIMDLevel()) {                                          \
+        case SIMDLevel::AVX512:                                        \
+            return avx512::kernel <avx512::traits> (__VA_ARGS__);      \
+        case SIMDLevel::AVX2:                                          \
+            return avx2::kernel <avx2::traits> (__VA_ARGS__);          \
+        case SIMDLevel::SSE2:                                          \
+            return sse2::kernel <sse2::traits> (__VA_ARGS__);          \
+        default:                                                       \
+            return scalar::kernel <scalar::traits> (__VA_ARGS__);      \
+    }
+#else
+#define EASYDSP_DISPATCH(kernel, traits, ...)                           \
+    return scalar::kernel <scalar::traits> (__VA_ARGS__);
+#endif
+
+/// @brief kernel(x, y, count) computes count outputs from an extended input of count+taps-1 samples
+/// @param body false skips the outputs that read only the signal (one kernel call from output taps-1 to size)
+template <class Sample, class Kernel>
+void convolveFull(const Sample* x, size_t size, size_t taps, Sample* y, Kernel kernel, bool body = true) {
+    const size_t history = taps - 1;
+    const size_t total = size + history;
+
+    ///<    outputs near the edges read samples outside the signal, they are computed in pieces of at most
+    ///<    taps-1 outputs from a zero padded copy, everything in between reads the signal directly
+    ///<    the scratch only grows, after the first call with the largest filter no call allocates
+    thread_local std::vector <Sample> scratch;
+    const size_t piece = std::max <size_t> (history, 1);
+    if (scratch.size() < piece + history) {
+        scratch.resize(piece + history);
+    }
+
+    size_t n = 0;
+    while (n < total) {
+        if (n >= history && n < size) {
+            if (body) {
+                kernel(x + (n - history), y + n, size - n);
+            }
+            n = size;
+            continue;
+        }
+
+        size_t end = std::min(total, n + piece);
+        if (n < history && history < size) {
+            end = std::min(end, history);
+        }
+
+        ///<    padded signal: history zeros, the signal, history zeros
+        for (size_t i = 0; i < end - n + history; ++i) {
+            const size_t k = n + i;
+            scratch[i] = (k >= history && k - history < size) ? x[k - history] : Sample(0);
+        }
+
+        kernel(scratch.data(), y + n, end - n);
+        n = end;
+    }
+}
+
+}
+
+void directKernel(const double* x, const double* h, size_t taps, double* y, size_t count) noexcept {
+    EASYDSP_DISPATCH(direct, Double, x, h, taps, y, count)
+}
+
+void directKernel(const float* x, const float* h, size_t taps, float* y, size_t count) noexcept {
+    EASYDSP_DISPATCH(direct, Float, x, h, taps, y, count)
+}
+
+void directKernel(const float* x, const double* h, size_t taps, float* y, size_t count) noexcept {
+    EASYDSP_DISPATCH(direct, Mixed, x, h, taps, y, count)
+}
+
+void foldedKernel(const double* x, const double* h, size_t taps, double* y, size_t count) noexcept {
+    EASYDSP_DISPATCH(folded, Double, x, h, taps, y, count)
+}
+
+void foldedKernel(const float* x, const float* h, size_t taps, float* y, size_t count) noexcept {
+    EASYDSP_DISPATCH(folded, Float, x, h, taps, y, count)
+}
+
+void foldedKernel(const float* x, const double* h, size_t taps, float* y, size_t count) noexcept {
+    EASYDSP_DISPATCH(folded, Mixed, x, h, taps, y, count)
+}
+
+void multichannelKernel(const double* x, const double* h, size_t taps, bool symmetric, size_t channels, double* y, size_t frames) noexcept {
+    if (symmetric) {
+        EASYDSP_DISPATCH(multichannelFolded, Double, x, h, taps, channels, y, frames)
+    }
+    EASYDSP_DISPATCH(multichannel, Double, x, h, taps, channels, y, frames)
+}
+
+void multichannelKernel(const float* x, const float* h, size_t taps, bool symmetric, size_t channels, float* y, size_t frames) noexcept {
+    if (symmetric) {
+        EASYDSP_DISPATCH(multichannelFolded, Float, x, h, taps, channels, y, frames)
+    }
+    EASYDSP_DISPATCH(multichannel, Float, x, h, taps, channels, y, frames)
+}
+
+void multichannelKernel(const float* x, const double* h, size_t taps, bool symmetric, size_t channels, float* y, size_t frames) noexcept {
+    if (symmetric) {
+        EASYDSP_DISPATCH(multichannelFolded, Mixed, x, h, taps, channels, y, frames)
+    }
+    EASYDSP_DISPATCH(multichannel, Mixed, x, h, taps, channels, y, frames)
+}
+
+void directConvolve(const double* x, size_t size, const double* h, size_t taps, bool symmetric, double* y) {
+    convolveFull(x, size, taps, y, [=](const auto* xp, auto* yp, size_t count) {
+        convolveKernel(xp, h, taps, symmetric, yp, count);
+    });
+}
+
+void directConvolve(const float* x, size_t size, const float* h, size_t taps, bool symmetric, float* y) {
+    convolveFull(x, size, taps, y, [=](const auto* xp, auto* yp, size_t count) {
+        convolveKernel(xp, h, taps, symmetric, yp, count);
+    });
+}
+
+void directConvolve(const float* x, size_t size, const double* h, size_t taps, bool symmetric, float* y) {
+    convolveFull(x, size, taps, y, [=](const auto* xp, auto* yp, size_t count) {
+        convolveKernel(xp, h, taps, symmetric, yp, count);
+    });
+}
+
+void directConvolveEdges(const double* x, size_t size, const double* h, size_t taps, bool symmetric, double* y) {
+    convolveFull(x, size, taps, y, [=](const auto* xp, auto* yp, size_t count) {
+        convolveKernel(xp, h, taps, symmetric, yp, count);
+    }, false);
+}
+
+void directConvolveEdges(const float* x, size_t size, const float* h, size_t taps, bool symmetric, float* y) {
+    convolveFull(x, size, taps, y, [=](const auto* xp, auto* yp, size_t count) {
+        convolveKernel(xp, h, taps, symmetric, yp, count);
+    }, false);
+}
+
+void directConvolveEdges(const float* x, size_t size, const double* h, size_t taps, bool symmetric, float* y) {
+    convolveFull(x, size, taps, y, [=](const auto* xp, auto* yp, size_t count) {
+        convolveKernel(xp, h, taps, symmetric, yp, count);
+    }, false);
+}
+
+void directConvolve(const int16_t* x, size_t size, const int16_t* h, size_t taps, int16_t* y) {
+    convolveFull(x, size, taps, y, [=](const int16_t* xp, int16_t* yp, size_t count) {
+        directKernel(xp, h, taps, yp, count);
+    });
+}
+
+void directConvolve(const int32_t* x, size_t size, const int32_t* h, size_t taps, int32_t* y) {
+    convolveFull(x, size, taps, y, [=](const int32_t* xp, int32_t* yp, size_t count) {
+        directKernel(xp, h, taps, yp, count);
+    });
+}
+
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+///<    internal header, not part of the public interface
+///<    every kernel has three versions: double samples and coefficients, float samples and coefficients,
+///<    and float samples with double coefficients (the sums are then calculated in double)
+///<    the fixed-point kernels (Q15 and Q31) have their own file, FixedKernels.cpp
+
+namespace oh::fir::detail {
+
+/// @brief output-major direct convolution: y[n] = sum h[j] * x[n + j] for n < count, j < taps
+/// uses the instruction set chosen by getSIMDLevel()
+/// @param x input, count+taps-1 samples
+/// @param h coefficients in reversed order
+/// @param taps number of coefficients
+/// @param y pointer to count output samples
+/// @param count number of outputs
+void directKernel(const double* x, const double* h, size_t taps, double* y, size_t count) noexcept;
+void directKernel(const float* x, const float* h, size_t taps, float* y, size_t count) noexcept;
+void directKernel(const float* x, const double* h, size_t taps, float* y, size_t count) noexcept;
+
+/// @brief fixed-point direct convolution: y[n] = saturate((sum h[j] * x[n + j] + rounding) >> fractional bits)
+/// the sum is kept in 64 bits with wrap-around, so every instruction set gives bit-exact results
+/// Q15 coefficients must lie in [-32767, 32767], two products of a multiply-add then always fit into 32 bits
+/// @param x input, count+taps-1 samples
+/// @param h coefficients in reversed order
+/// @param taps number of coefficients
+/// @param y pointer to count output samples
+/// @param count number of outputs
+void directKernel(const int16_t* x, const int16_t* h, size_t taps, int16_t* y, size_t count) noexcept;
+void directKernel(const int32_t* x, const int32_t* h, size_t taps, int32_t* y, size_t count) noexcept;
+
+/// @brief same as directKernel for symmetric coefficients (h[j] == h[taps-1-j]), mirrored samples are added first
+/// @param x input, count+taps-1 samples
+/// @param h symmetric coefficients
+/// @param taps number of coefficients
+/// @param y pointer to count output samples
+/// @param count number of outputs
+void foldedKernel(const double* x, const double* h, size_t taps, double* y, size_t count) noexcept;
+void foldedKernel(const float* x, const float* h, size_t taps, float* y, size_t count) noexcept;
+void foldedKernel(const float* x, const double* h, size_t taps, float* y, size_t count) noexcept;
+
+/// @brief calls foldedKernel for symmetric coefficients and directKernel otherwise
+template <class Sample, class Coefficient>
+void convolveKernel(const Sample* x, const Coefficient* h, size_t taps, bool symmetric, Sample* y, size_t count) noexcept {
+    if (symmetric) {
+        foldedKernel(x, h, taps, y, count);
+    } else {
+        directKernel(x, h, taps, y, count);
+    }
+}
+
+/// @brief direct convolution of interleaved channels: y[f * channels + c] = sum h[j] * x[(f + j) * channels + c]
+/// the simd lanes span channels, symmetric coefficients use the folded version
+/// @param x input, frames+taps-1 interleaved frames
+/// @param h coefficients in reversed order
+/// @param taps number of coefficients
+/// @param symmetric true if the coefficients are symmetric
+/// @param channels number of channels in a frame
+/// @param y pointer to frames output frames
+/// @param frames number of output frames
+void multichannelKernel(const double* x, const double* h, size_t taps, bool symmetric, size_t channels, double* y, size_t frames) noexcept;
+void multichannelKernel(const float* x, const float* h, size_t taps, bool symmetric, size_t channels, float* y, size_t frames) noexcept;
+void multichannelKernel(const float* x, const double* h, size_t taps, bool symmetric, size_t channels, float* y, size_t frames) noexcept;
+
+/// @brief full convolution (size+taps-1 outputs) using convolveKernel, samples outside the signal are treated as zeros
+/// @param x input signal
+/// @param size number of input samples
+/// @param h coefficients in reversed order
+/// @param taps number of coefficients
+/// @param symmetric true if the coefficients are symmetric
+/// @param y pointer to size+taps-1 output samples
+/// the zero padded edges use a scratch buffer kept per thread, so repeated calls do not allocate
+void directConvolve(const double* x, size_t size, const double* h, size_t taps, bool symmetric, double* y);
+void directConvolve(const float* x, size_t size, const float* h, size_t taps, bool symmetric, float* y);
+void directConvolve(const float* x, size_t size, const double* h, size_t taps, bool symmetric, float* y);
+
+/// @brief only the outputs of directConvolve that read samples outside the signal (n < taps-1 and n >= size),
+/// calculated exactly as directConvolve does, the rest is one convolveKernel call on x from output taps-1,
+/// which gives identical results when split at multiples of 64 outputs
+/// @param x input signal
+/// @param size number of input samples
+/// @param h coefficients in reversed order
+/// @param taps number of coefficients
+/// @param symmetric true if the coefficients are symmetric
+/// @param y pointer to size+taps-1 output samples, only the edges are written
+void directConvolveEdges(const double* x, size_t size, const double* h, size_t taps, bool symmetric, double* y);
+void directConvolveEdges(const float* x, size_t size, const float* h, size_t taps, bool symmetric, float* y);
+void directConvolveEdges(const float* x, size_t size, const double* h, size_t taps, bool symmetric, float* y);
+
+/// @brief full fixed-point convolution (size+taps-1 outputs) using the fixed-point directKernel
+/// @param x input signal
+/// @param size number of input samples
+/// @param h coefficients in reversed order
+/// @param taps number of coefficients
+/// @param y pointer to size+taps-1 output samples
+void directConvolve(const int16_t* x, size_t size, const int16_t* h, size_t taps, int16_t* y);
+void directConvolve(const int32_t* x, size_t size, const int32_t* h, size_t taps, int32_t* y);
+
+}
@@ -0,0 +1,193 @@
+#include "detail/MappedFile.hpp"
+
+#include <algorithm>
+#include <utility>
+
+///<    posix systems map the file with mmap, windows with a file mapping object, anything else reads the file into memory
+
+#if defined(_WIN32)
+#define EASYDSP_MAPPING_WINDOWS 1
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#define EASYDSP_MAPPING_POSIX 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <cstdio>
+#include <memory>
+#include <system_error>
+#endif
+
+namespace oh::fir::detail {
+
+namespace {
+
+/// @brief releases what open() made for a nonempty file
+void unmap(const std::byte* data, [[maybe_unused]] size_t size) noexcept {
+#if defined(EASYDSP_MAPPING_WINDOWS)
+    ::UnmapViewOfFile(data);
+#elif defined(EASYDSP_MAPPING_POSIX)
+    ::munmap(const_cast <std::byte*> (data), size);
+#else
+    delete[] data;
+#endif
+}
+
+}
+
+MappedFile::MappedFile(const std::byte* data, size_t size) noexcept : m_data(data), m_size(size) {}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+: m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        if (m_data != nullptr) {
+            unmap(m_data, m_size);
+        }
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+    if (m_data != nullptr) {
+        unmap(m_data, m_size);
+    }
+}
+
+#if defined(EASYDSP_MAPPING_WINDOWS)
+
+std::expected <MappedFile, FIRError> MappedFile::open(const std::filesystem::path& path) {
+    HANDLE file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return std::unexpected(FIRError::FileError);
+    }
+
+    LARGE_INTEGER info;
+    if (!::GetFileSizeEx(file, &info) || ::GetFileType(file) != FILE_TYPE_DISK) {
+        ::CloseHandle(file);
+        return std::unexpected(FIRError::FileError);
+    }
+
+    const size_t size = static_cast <size_t> (info.QuadPart);
+    if (size == 0) {
+        ::CloseHandle(file);
+        return MappedFile(nullptr, 0);
+    }
+
+    ///<    the view keeps its own references to the mapping and the file
+    HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    ::CloseHandle(file);
+    if (mapping == nullptr) {
+        return std::unexpected(FIRError::FileError);
+    }
+    void* data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    ::CloseHandle(mapping);
+    if (data == nullptr) {
+        return std::unexpected(FIRError::FileError);
+    }
+
+    return MappedFile(static_cast <const std::byte*> (data), size);
+}
+
+void MappedFile::release(size_t offset, size_t size) const noexcept {
+    SYSTEM_INFO system;
+    ::GetSystemInfo(&system);
+    const size_t page = system.dwPageSize;
+    const size_t first = offset / page * page;
+    const size_t last = std::min(offset + size, m_size) / page * page;
+    if (m_data != nullptr && first < last) {
+        ///<    unlocking pages that are not locked removes them from the working set (and fails, which is expected)
+        ::VirtualUnlock(const_cast <std::byte*> (m_data) + first, last - first);
+    }
+}
+
+#elif defined(EASYDSP_MAPPING_POSIX)
+
+std::expected <MappedFile, FIRError> MappedFile::open(const std::filesystem::path& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return std::unexpected(FIRError::FileError);
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        ::close(fd);
+        return std::unexpected(FIRError::FileError);
+    }
+
+    const size_t size = static_cast <size_t> (info.st_size);
+    if (size == 0) {
+        ::close(fd);
+        return MappedFile(nullptr, 0);
+    }
+
+    void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ///<    the mapping keeps its own reference to the file
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        return std::unexpected(FIRError::FileError);
+    }
+
+    ::madvise(data, size, MADV_SEQUENTIAL);
+    return MappedFile(static_cast <const std::byte*> (data), size);
+}
+
+void MappedFile::release(size_t offset, size_t size) const noexcept {
+    const size_t page = static_cast <size_t> (::sysconf(_SC_PAGESIZE));
+    const size_t first = offset / page * page;
+    const size_t last = std::min(offset + size, m_size) / page * page;
+    if (m_data != nullptr && first < last) {
+        ::madvise(const_cast <std::byte*> (m_data) + first, last - first, MADV_DONTNEED);
+    }
+}
+
+#else
+
+std::expected <MappedFile, FIRError> MappedFile::open(const std::filesystem::path& path) {
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(path, error)) {
+        return std::unexpected(FIRError::FileError);
+    }
+    const auto size = static_cast <size_t> (std::filesystem::file_size(path, error));
+    if (error) {
+        return std::unexpected(FIRError::FileError);
+    }
+    if (size == 0) {
+        return MappedFile(nullptr, 0);
+    }
+
+    std::unique_ptr <std::FILE, decltype(&std::fclose)> file(std::fopen(path.string().c_str(), "rb"), &std::fclose);
+    std::unique_ptr <std::byte[]> data(new std::byte[size]);
+    if (!file || std::fread(data.get(), 1, size, file.get()) != size) {
+        return std::unexpected(FIRError::FileError);
+    }
+
+    return MappedFile(data.release(), size);
+}
+
+void MappedFile::release(size_t, size_t) const noexcept {
+    ///<    the whole file is in memory until the object is destroyed
+}
+
+#endif
+
+const std::byte* MappedFile::getData() const noexcept {
+    return m_data;
+}
+
+size_t MappedFile::getSize() const noexcept {
+    return m_size;
+}
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "FIR.hpp"
+
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+
+///<    internal header, not part of the public interface
+
+namespace oh::fir::detail {
+
+/// @brief read-only memory mapping of a whole file (mmap on posix systems, a file mapping object on windows)
+/// the pages are loaded by the kernel on first access and can be released again with release(),
+/// so reading a file front to back keeps only a window of it resident
+/// on other systems the file is read into memory by open() and release() does nothing
+class MappedFile {
+
+    private:
+
+    const std::byte* m_data = nullptr;
+
+    size_t m_size = 0;
+
+    /// @brief constructor, mapping must be handled by open()
+    /// @param data start of the mapping
+    /// @param size size of the file in bytes
+    MappedFile(const std::byte* data, size_t size) noexcept;
+
+    public:
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    ~MappedFile();
+
+    /// @brief maps a file for sequential reading
+    /// @param path file to be mapped
+    /// @return MappedFile object on success, FIRError::FileError on failure
+    static std::expected <MappedFile, FIRError> open(const std::filesystem::path& path);
+
+    /// @brief drops the resident pages from the one holding offset up to the last one that ends inside the range,
+    /// nothing before offset+size may be read again, the page straddling the end is kept and is dropped by the next call
+    /// when that starts where this one ended, so a reader releasing behind itself leaves at most one page behind
+    /// @param offset first byte of the range, the start of its page is released too
+    /// @param size bytes in the range
+    void release(size_t offset, size_t size) const noexcept;
+
+    /// @brief getter for data
+    /// @return start of the file, nullptr for an empty file
+    const std::byte* getData() const noexcept;
+
+    /// @brief getter for size
+    /// @return size of the file in bytes
+    size_t getSize() const noexcept;
+
+};
+
+}
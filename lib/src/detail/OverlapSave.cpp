@@ -0,0 +1,132 @@
+#include "detail/OverlapSave.hpp"
+#include "SIMD.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace oh::fir::detail {
+
+namespace {
+
+///<    cost of one real fft of size n relative to a scalar multiply-add, measured on the direct loop and RealFFT
+constexpr double FFT_COST_FACTOR = 3.0;
+
+///<    cost of the folded kernels relative to the plain ones, half the multiplies but the same number of loads
+constexpr double FOLDED_COST_FACTOR = 0.6;
+
+///<    the direct loop is preferred below this size, fft blocks would be mostly overlap
+constexpr size_t MIN_TAPS_FOR_FFT = 64;
+
+///<    cost of one multiply-add of the direct kernels relative to the scalar loop, measured per instruction set
+double directCostFactor() noexcept {
+    switch (getSIMDLevel()) {
+        case SIMDLevel::AVX512:
+            return 0.1;
+        case SIMDLevel::AVX2:
+            return 0.15;
+        case SIMDLevel::SSE2:
+            return 0.3;
+        default:
+            return 1.0;
+    }
+}
+
+double fftCost(size_t fft_size) noexcept {
+    return FFT_COST_FACTOR * fft_size * std::log2(static_cast <double> (fft_size));
+}
+
+}
+
+OverlapSave::OverlapSave(const double* coefficients, size_t taps, size_t fft_size)
+: m_taps(taps), m_step(fft_size - taps + 1), m_fft(fft_size),
+  m_spectrum(fft_size / 2 + 1), m_time(fft_size, 0.0), m_frequency(fft_size / 2 + 1), m_scratch(fft_size / 2) {
+    std::copy(coefficients, coefficients + taps, m_time.begin());
+    m_fft.forward(m_time.data(), m_spectrum.data(), m_scratch.data());
+
+    const double scale = 1.0 / fft_size;
+    for (auto& v : m_spectrum) {
+        v *= scale;
+    }
+}
+
+template <class Sample>
+void OverlapSave::process(const Sample* x, size_t count, Sample* y) noexcept {
+    const size_t L = m_fft.getSize();
+    const size_t history = m_taps - 1;
+
+    for (size_t position = 0; position < count; position += m_step) {
+        const size_t outputs = std::min(m_step, count - position);
+        const size_t available = history + outputs;
+
+        ///<    the last block may be shorter than the fft, the missing samples are never part of a valid output
+        std::copy(x + position, x + position + available, m_time.begin());
+        std::fill(m_time.begin() + available, m_time.end(), 0.0);
+
+        m_fft.forward(m_time.data(), m_frequency.data(), m_scratch.data());
+
+        for (size_t k = 0; k <= L / 2; ++k) {
+            m_frequency[k] *= m_spectrum[k];
+        }
+
+        m_fft.inverse(m_frequency.data(), m_time.data(), m_scratch.data());
+
+        ///<    the first taps-1 samples are corrupted by the circular wrap
+        std::copy(m_time.begin() + history, m_time.begin() + history + outputs, y + position);
+    }
+}
+
+template void OverlapSave::process <double> (const double* x, size_t count, double* y) noexcept;
+template void OverlapSave::process <float> (const float* x, size_t count, float* y) noexcept;
+
+size_t OverlapSave::getStep() const noexcept {
+    return m_step;
+}
+
+size_t OverlapSave::chooseFFTSize(size_t taps) noexcept {
+    const size_t smallest = std::max <size_t> (nextPowerOfTwo(2 * taps), 64);
+
+    size_t best = smallest;
+    double best_cost = estimateCost(taps, best - taps + 1, best) / (best - taps + 1);
+
+    for (size_t L = smallest * 2; L <= smallest * 16; L *= 2) {
+        const double cost = estimateCost(taps, L - taps + 1, L) / (L - taps + 1);
+        if (cost < best_cost) {
+            best = L;
+            best_cost = cost;
+        }
+    }
+
+    return best;
+}
+
+double OverlapSave::estimateCost(size_t taps, size_t outputs, size_t fft_size) noexcept {
+    const size_t step = fft_size - taps + 1;
+    const size_t blocks = (outputs + step - 1) / step;
+
+    ///<    forward and inverse fft plus the complex product (about 3 multiply-adds per bin)
+    return blocks * (2.0 * fftCost(fft_size) + 3.0 * (fft_size / 2 + 1));
+}
+
+double OverlapSave::estimateDirectCost(size_t taps, size_t outputs, bool symmetric, bool single_precision) noexcept {
+    return directCostFactor() * (symmetric ? FOLDED_COST_FACTOR : 1.0) * (single_precision ? 0.5 : 1.0) * taps * outputs;
+}
+
+double OverlapSave::estimateBestCost(size_t taps, size_t outputs, bool symmetric, bool single_precision) noexcept {
+    const double direct = estimateDirectCost(taps, outputs, symmetric, single_precision);
+    if (!isCheaper(taps, outputs, symmetric, single_precision)) {
+        return direct;
+    }
+    return estimateCost(taps, outputs, chooseFFTSize(taps));
+}
+
+bool OverlapSave::isCheaper(size_t taps, size_t outputs, bool symmetric, bool single_precision) noexcept {
+    if (taps < MIN_TAPS_FOR_FFT || outputs == 0) {
+        return false;
+    }
+
+    ///<    the spectrum of the coefficients is calculated once per engine and is not counted here
+    const size_t L = chooseFFTSize(taps);
+    return estimateCost(taps, outputs, L) < estimateDirectCost(taps, outputs, symmetric, single_precision);
+}
+
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "detail/FFT.hpp"
+
+#include <vector>
+#include <complex>
+#include <cstddef>
+
+///<    internal header, not part of the public interface
+
+namespace oh::fir::detail {
+
+/// @brief overlap-save fft convolution engine
+/// works on an extended input: size-1 samples of history followed by the samples to be filtered,
+/// the same layout as the direct kernels, so both can be used interchangeably
+class OverlapSave {
+
+    private:
+
+    size_t m_taps;
+
+    /// @brief number of valid outputs produced by one fft block (fft size - taps + 1)
+    size_t m_step;
+
+    RealFFT m_fft;
+
+    /// @brief spectrum of the coefficients, already scaled by 1/fft size
+    std::vector <std::complex <double>> m_spectrum;
+
+    ///<    scratch memory, allocated once
+    std::vector <double> m_time;
+    std::vector <std::complex <double>> m_frequency;
+    std::vector <std::complex <double>> m_scratch;
+
+    public:
+
+    /// @brief constructor
+    /// @param coefficients pointer to the coefficients (not reversed)
+    /// @param taps number of coefficients
+    /// @param fft_size size of the fft, power of two, at least 2*taps
+    OverlapSave(const double* coefficients, size_t taps, size_t fft_size);
+
+    /// @brief filters count samples, float samples are converted while they are copied into the fft buffer
+    /// @param x extended input: taps-1 samples of history followed by count samples
+    /// @param count number of outputs
+    /// @param y pointer to count output samples
+    template <class Sample>
+    void process(const Sample* x, size_t count, Sample* y) noexcept;
+
+    size_t getStep() const noexcept;
+
+    /// @brief picks the fft size with the lowest estimated cost per output
+    /// @param taps number of coefficients
+    /// @return fft size
+    static size_t chooseFFTSize(size_t taps) noexcept;
+
+    /// @brief estimated cost of computing outputs with fft blocks of the given size, in multiply-add units
+    /// @param taps number of coefficients
+    /// @param outputs number of outputs
+    /// @param fft_size size of the fft
+    /// @return estimated cost
+    static double estimateCost(size_t taps, size_t outputs, size_t fft_size) noexcept;
+
+    /// @brief estimated cost of computing outputs with the direct loop, in the same units as estimateCost()
+    /// @param taps number of coefficients
+    /// @param outputs number of outputs
+    /// @param symmetric true if the folded kernels can be used
+    /// @param single_precision true if the loop works on float coefficients (twice the lanes)
+    /// @return estimated cost
+    static double estimateDirectCost(size_t taps, size_t outputs, bool symmetric, bool single_precision) noexcept;
+
+    /// @brief estimated cost of the cheaper of the direct loop and overlap-save, as chosen by isCheaper()
+    /// @param taps number of coefficients
+    /// @param outputs number of outputs
+    /// @param symmetric true if the folded kernels can be used
+    /// @param single_precision true if the loop works on float coefficients (twice the lanes)
+    /// @return estimated cost
+    static double estimateBestCost(size_t taps, size_t outputs, bool symmetric, bool single_precision) noexcept;
+
+    /// @brief compares the cost model of the direct loop and overlap-save
+    /// @param taps number of coefficients
+    /// @param outputs number of outputs
+    /// @param symmetric true if the direct loop can use the folded kernels
+    /// @param single_precision true if the direct loop works on float coefficients (twice the lanes)
+    /// @return true if overlap-save is expected to be faster
+    static bool isCheaper(size_t taps, size_t outputs, bool symmetric, bool single_precision) noexcept;
+
+};
+
+}
@@ -0,0 +1,59 @@
+#include "detail/Polyphase.hpp"
+#include "detail/FFT.hpp"
+
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <algorithm>
+
+namespace oh::fir::detail {
+
+namespace {
+
+///<    the response is sampled on a grid with this many points per coefficient (at least MIN_GRID_SIZE points) from 0 to 0.5
+constexpr size_t GRID_DENSITY = 8;
+constexpr size_t MIN_GRID_SIZE = 512;
+
+}
+
+size_t getPhaseLength(size_t taps, size_t factor) noexcept {
+    return (taps + factor - 1) / factor;
+}
+
+std::vector <double> splitPhases(const std::vector <double>& coefficients, size_t factor) {
+    const size_t T = getPhaseLength(coefficients.size(), factor);
+    const size_t padding = T * factor - coefficients.size();
+    std::vector <double> phases(T * factor, 0.0);
+
+    for (size_t n = 0; n < coefficients.size(); ++n) {
+        const size_t k = n + padding;
+        phases[(k % factor) * T + k / factor] = coefficients[n];
+    }
+
+    return phases;
+}
+
+bool isBandLimited(const std::vector <double>& coefficients, double edge) {
+    ///<    the bins of a zero padded real fft are the response on the grid, O(M log M) instead of M trig terms per point
+    const size_t size = nextPowerOfTwo(2 * std::max(MIN_GRID_SIZE, GRID_DENSITY * coefficients.size()));
+    const RealFFT fft(size);
+    std::vector <double> padded(size, 0.0);
+    std::copy(coefficients.begin(), coefficients.end(), padded.begin());
+    std::vector <std::complex <double>> bins(size / 2 + 1);
+    std::vector <std::complex <double>> scratch(size / 2);
+    fft.forward(padded.data(), bins.data(), scratch.data());
+
+    double largest = 0.0;
+    double stopband = 0.0;
+    for (size_t k = 0; k < bins.size(); ++k) {
+        const double gain = std::abs(bins[k]);
+        largest = std::max(largest, gain);
+        if (static_cast <double> (k) / size >= edge) {
+            stopband = std::max(stopband, gain);
+        }
+    }
+
+    return stopband <= largest * std::numbers::sqrt2 / 2.0;
+}
+
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+///<    internal header, not part of the public interface
+
+namespace oh::fir::detail {
+
+/// @brief number of coefficients of every phase
+/// @param taps number of coefficients
+/// @param factor number of phases
+/// @return ceil(taps / factor)
+size_t getPhaseLength(size_t taps, size_t factor) noexcept;
+
+/// @brief splits coefficients into factor phases, after padding them in front with zeros to a multiple of factor
+/// phase p holds padded[i * factor + p], the phases are stored one after another
+/// @param coefficients coefficients to be split
+/// @param factor number of phases
+/// @return factor*getPhaseLength() coefficients
+std::vector <double> splitPhases(const std::vector <double>& coefficients, size_t factor);
+
+/// @brief checks that a filter removes what would alias (or image) when the rate changes around edge
+/// the gain at every frequency from edge to 0.5 must be at least 3 dB below the largest gain of the filter
+/// @param coefficients coefficients of the filter
+/// @param edge normalised frequency, 0.5 divided by the rate change factor
+/// @return true if the filter is band limited to edge
+bool isBandLimited(const std::vector <double>& coefficients, double edge);
+
+}
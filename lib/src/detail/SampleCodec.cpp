@@ -0,0 +1,97 @@
+#include "detail/SampleCodec.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace oh::fir::detail {
+
+///<    the stored formats are little endian, plain memcpy is only right on little endian hosts
+static_assert(std::endian::native == std::endian::little, "sample files are little endian");
+
+namespace {
+
+/// @brief reads samples of type T one by one, memcpy keeps unaligned inputs legal and compiles to plain loads
+template <class T, class Real>
+void decode(const std::byte* input, Real* output, size_t count, double scale) noexcept {
+    for (size_t i = 0; i < count; ++i) {
+        T v;
+        std::memcpy(&v, input + i * sizeof(T), sizeof(T));
+        output[i] = static_cast <Real> (static_cast <double> (v) * scale);
+    }
+}
+
+/// @brief writes integer samples of the given width, full scale is 2^(8*bytes-1)
+template <class Real>
+void encodeInteger(const Real* input, std::byte* output, size_t count, size_t bytes) noexcept {
+    const double scale = std::ldexp(1.0, static_cast <int> (8 * bytes - 1));
+    for (size_t i = 0; i < count; ++i) {
+        const double v = std::clamp(std::nearbyint(static_cast <double> (input[i]) * scale), -scale, scale - 1.0);
+        const int32_t s = std::isnan(v) ? 0 : static_cast <int32_t> (v);
+        std::memcpy(output + i * bytes, &s, bytes);
+    }
+}
+
+}
+
+template <class Real>
+void decodeSamples(const std::byte* input, SampleFormat format, Real* output, size_t count) noexcept {
+    switch (format) {
+        case SampleFormat::Int16:
+            decode <int16_t> (input, output, count, 0x1p-15);
+            break;
+        case SampleFormat::Int24:
+            ///<    the 3 bytes go to the top of an int32, the arithmetic shift extends the sign
+            for (size_t i = 0; i < count; ++i) {
+                int32_t v = 0;
+                std::memcpy(reinterpret_cast <std::byte*> (&v) + 1, input + 3 * i, 3);
+                output[i] = static_cast <Real> ((v >> 8) * 0x1p-23);
+            }
+            break;
+        case SampleFormat::Int32:
+            decode <int32_t> (input, output, count, 0x1p-31);
+            break;
+        case SampleFormat::Float32:
+            decode <float> (input, output, count, 1.0);
+            break;
+        case SampleFormat::Float64:
+            decode <double> (input, output, count, 1.0);
+            break;
+    }
+}
+
+template <class Real>
+void encodeSamples(const Real* input, SampleFormat format, std::byte* output, size_t count) noexcept {
+    switch (format) {
+        case SampleFormat::Int16:
+            encodeInteger(input, output, count, 2);
+            break;
+        case SampleFormat::Int24:
+            encodeInteger(input, output, count, 3);
+            break;
+        case SampleFormat::Int32:
+            encodeInteger(input, output, count, 4);
+            break;
+        case SampleFormat::Float32:
+            for (size_t i = 0; i < count; ++i) {
+                const float s = static_cast <float> (input[i]);
+                std::memcpy(output + i * sizeof(float), &s, sizeof(float));
+            }
+            break;
+        case SampleFormat::Float64:
+            for (size_t i = 0; i < count; ++i) {
+                const double s = static_cast <double> (input[i]);
+                std::memcpy(output + i * sizeof(double), &s, sizeof(double));
+            }
+            break;
+    }
+}
+
+template void decodeSamples <double> (const std::byte*, SampleFormat, double*, size_t) noexcept;
+template void decodeSamples <float> (const std::byte*, SampleFormat, float*, size_t) noexcept;
+template void encodeSamples <double> (const double*, SampleFormat, std::byte*, size_t) noexcept;
+template void encodeSamples <float> (const float*, SampleFormat, std::byte*, size_t) noexcept;
+
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "SampleFormat.hpp"
+
+#include <cstddef>
+
+///<    internal header, not part of the public interface
+
+namespace oh::fir::detail {
+
+/// @brief converts stored samples to double or float, integers are scaled to [-1, 1)
+/// @tparam Real double or float
+/// @param input count samples in the given format, any alignment
+/// @param format format of the stored samples
+/// @param output count samples
+/// @param count number of samples
+template <class Real>
+void decodeSamples(const std::byte* input, SampleFormat format, Real* output, size_t count) noexcept;
+
+/// @brief converts double or float samples to a stored format, integers are rounded and saturated
+/// @tparam Real double or float
+/// @param input count samples
+/// @param format format of the stored samples
+/// @param output room for count samples in the given format, any alignment
+/// @param count number of samples
+template <class Real>
+void encodeSamples(const Real* input, SampleFormat format, std::byte* output, size_t count) noexcept;
+
+extern template void decodeSamples <double> (const std::byte*, SampleFormat, double*, size_t) noexcept;
+extern template void decodeSamples <float> (const std::byte*, SampleFormat, float*, size_t) noexcept;
+extern template void encodeSamples <double> (const double*, SampleFormat, std::byte*, size_t) noexcept;
+extern template void encodeSamples <float> (const float*, SampleFormat, std::byte*, size_t) noexcept;
+
+}
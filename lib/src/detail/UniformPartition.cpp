@@ -0,0 +1,108 @@
+#include "detail/UniformPartition.hpp"
+
+#include <algorithm>
+
+namespace oh::fir::detail {
+
+UniformPartition::UniformPartition(const double* coefficients, size_t count, size_t block_size, size_t delay)
+: m_block_size(block_size), m_partitions((count + block_size - 1) / block_size), m_fft(2 * block_size),
+  m_filter_spectra(m_partitions * (block_size + 1)), m_delay_line(m_partitions * (block_size + 1)), m_delay_line_position(0),
+  m_window(2 * block_size, 0.0), m_fill(0), m_output(block_size, 0.0), m_delay(delay, 0.0), m_delay_position(0),
+  m_time(2 * block_size, 0.0), m_accumulator(block_size + 1), m_scratch(block_size) {
+    const size_t bins = block_size + 1;
+    const double scale = 1.0 / (2 * block_size);
+
+    for (size_t p = 0; p < m_partitions; ++p) {
+        const size_t first = p * block_size;
+        const size_t last = std::min(count, first + block_size);
+
+        std::fill(m_time.begin(), m_time.end(), 0.0);
+        std::copy(coefficients + first, coefficients + last, m_time.begin());
+
+        std::complex <double>* spectrum = m_filter_spectra.data() + p * bins;
+        m_fft.forward(m_time.data(), spectrum, m_scratch.data());
+
+        for (size_t k = 0; k < bins; ++k) {
+            spectrum[k] *= scale;
+        }
+    }
+}
+
+void UniformPartition::computeBlock() noexcept {
+    const size_t B = m_block_size;
+    const size_t bins = B + 1;
+
+    std::complex <double>* newest = m_delay_line.data() + m_delay_line_position * bins;
+    m_fft.forward(m_window.data(), newest, m_scratch.data());
+
+    std::fill(m_accumulator.begin(), m_accumulator.end(), std::complex <double> (0.0, 0.0));
+
+    ///<    partition p of the coefficients meets the input window from p blocks ago
+    for (size_t p = 0; p < m_partitions; ++p) {
+        const size_t slot = (m_delay_line_position + m_partitions - p) % m_partitions;
+        const std::complex <double>* x = m_delay_line.data() + slot * bins;
+        const std::complex <double>* h = m_filter_spectra.data() + p * bins;
+
+        for (size_t k = 0; k < bins; ++k) {
+            m_accumulator[k] += x[k] * h[k];
+        }
+    }
+
+    m_fft.inverse(m_accumulator.data(), m_time.data(), m_scratch.data());
+
+    ///<    the first half is corrupted by the circular wrap
+    std::copy(m_time.begin() + B, m_time.end(), m_output.begin());
+    std::copy(m_window.begin() + B, m_window.end(), m_window.begin());
+
+    m_delay_line_position = (m_delay_line_position + 1) % m_partitions;
+}
+
+void UniformPartition::push(const double* x, size_t count) noexcept {
+    double* destination = m_window.data() + m_block_size + m_fill;
+
+    if (m_delay.empty()) {
+        std::copy(x, x + count, destination);
+    } else {
+        const size_t D = m_delay.size();
+        for (size_t i = 0; i < count; ++i) {
+            destination[i] = m_delay[m_delay_position];
+            m_delay[m_delay_position] = x[i];
+            m_delay_position = (m_delay_position + 1 == D) ? 0 : m_delay_position + 1;
+        }
+    }
+
+    m_fill += count;
+
+    if (m_fill == m_block_size) {
+        computeBlock();
+        m_fill = 0;
+    }
+}
+
+size_t UniformPartition::getFill() const noexcept {
+    return m_fill;
+}
+
+const double* UniformPartition::getOutput() const noexcept {
+    return m_output.data();
+}
+
+size_t UniformPartition::getBlockSize() const noexcept {
+    return m_block_size;
+}
+
+size_t UniformPartition::getPartitionCount() const noexcept {
+    return m_partitions;
+}
+
+void UniformPartition::reset() noexcept {
+    std::fill(m_delay_line.begin(), m_delay_line.end(), std::complex <double> (0.0, 0.0));
+    std::fill(m_window.begin(), m_window.end(), 0.0);
+    std::fill(m_output.begin(), m_output.end(), 0.0);
+    std::fill(m_delay.begin(), m_delay.end(), 0.0);
+    m_delay_line_position = 0;
+    m_delay_position = 0;
+    m_fill = 0;
+}
+
+}
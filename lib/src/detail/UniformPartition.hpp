@@ -0,0 +1,87 @@
+#pragma once
+
+#include "detail/FFT.hpp"
+
+#include <vector>
+#include <complex>
+#include <cstddef>
+
+///<    internal header, not part of the public interface
+
+namespace oh::fir::detail {
+
+/// @brief one uniformly partitioned overlap-save stage with a frequency-domain delay line
+/// the stage convolves its (optionally delayed) input with a segment of the coefficients,
+/// every block_size input samples it produces block_size outputs
+class UniformPartition {
+
+    private:
+
+    size_t m_block_size;
+
+    size_t m_partitions;
+
+    /// @brief fft of size 2*block_size
+    RealFFT m_fft;
+
+    /// @brief spectra of the partitions, block_size+1 bins each, scaled by 1/fft size
+    std::vector <std::complex <double>> m_filter_spectra;
+
+    /// @brief spectra of the last partitions-many input windows, used as a ring
+    std::vector <std::complex <double>> m_delay_line;
+
+    size_t m_delay_line_position;
+
+    /// @brief previous input block followed by the block being filled
+    std::vector <double> m_window;
+
+    size_t m_fill;
+
+    /// @brief outputs of the last computed block
+    std::vector <double> m_output;
+
+    /// @brief input delay, aligns the output of this stage with the first stage
+    std::vector <double> m_delay;
+
+    size_t m_delay_position;
+
+    ///<    scratch memory, allocated once
+    std::vector <double> m_time;
+    std::vector <std::complex <double>> m_accumulator;
+    std::vector <std::complex <double>> m_scratch;
+
+    /// @brief transforms the full window and produces block_size outputs
+    void computeBlock() noexcept;
+
+    public:
+
+    /// @brief constructor
+    /// @param coefficients pointer to the coefficients of this segment (not reversed)
+    /// @param count number of coefficients in the segment
+    /// @param block_size partition and block size, power of two
+    /// @param delay number of samples the input is delayed by before it reaches the stage
+    UniformPartition(const double* coefficients, size_t count, size_t block_size, size_t delay);
+
+    /// @brief feeds samples into the stage, count must not cross a block boundary of the stage
+    /// @param x input samples
+    /// @param count number of samples
+    void push(const double* x, size_t count) noexcept;
+
+    /// @brief position in the current block, outputs of the last block are read from here
+    /// @return number of samples pushed since the last computed block
+    size_t getFill() const noexcept;
+
+    /// @brief getter for the outputs of the last computed block
+    /// @return pointer to block_size samples
+    const double* getOutput() const noexcept;
+
+    size_t getBlockSize() const noexcept;
+
+    size_t getPartitionCount() const noexcept;
+
+    /// @brief clears all state
+    void reset() noexcept;
+
+};
+
+}
@@ -0,0 +1,158 @@
+#include "detail/WindowTables.hpp"
+
+#include <map>
+#include <mutex>
+#include <cmath>
+#include <numbers>
+#include <utility>
+#include <cstdint>
+#include <algorithm>
+
+namespace oh::wnd::detail {
+
+namespace {
+
+struct CacheEntry {
+    WindowTable table;
+    uint64_t last_use;                      ///<    value of the use counter when the table was last returned
+};
+
+/// @brief the cache, one per process
+struct WindowCache {
+    std::mutex mutex;
+    std::map <std::pair <WindowType, size_t>, CacheEntry> entries;
+    size_t samples = 0;                     ///<    number of coefficients in all entries
+    uint64_t uses = 0;
+};
+
+/// @brief number of cosines calculated from one block start
+constexpr size_t WINDOW_BLOCK = 64;
+
+WindowCache& getCache() {
+    static WindowCache cache;
+    return cache;
+}
+
+}
+
+std::expected <std::vector <double>, WindowError> calculateWindow(WindowType w_type, size_t size) {
+    const size_t N = size;
+    const size_t half = (N + 1) / 2;
+
+    if (w_type == WindowType::Rectangular) {
+        return std::vector <double> (N, 1.0);
+    }
+
+    if (w_type != WindowType::Hamming && w_type != WindowType::Hanning && w_type != WindowType::Blackman) {
+        return std::unexpected(WindowError::InvalidType);
+    }
+
+    ///<    the windows are symmetric, the first half holds cos(2*pi*n/(N-1)) first, then the window, then it is mirrored
+    std::vector <double> coefficients(N);
+    double* c = coefficients.data();
+
+    ///<    cos(a+b) = cos(a)cos(b) - sin(a)sin(b) with a at the start of a block and b inside it, both exact from std::cos,
+    ///<    so the error stays at a few ulp for any size, while std::cos runs twice per block and the rest vectorises
+    const double step = 2.0 * std::numbers::pi / (N - 1);
+    const size_t block = std::min(WINDOW_BLOCK, half);
+    std::vector <double> offset_cos(block);
+    std::vector <double> offset_sin(block);
+    for (size_t j = 0; j < block; ++j) {
+        offset_cos[j] = std::cos(step * j);
+        offset_sin[j] = std::sin(step * j);
+    }
+
+    for (size_t start = 0; start < half; start += block) {
+        const size_t count = std::min(block, half - start);
+        const double start_cos = std::cos(step * start);
+        const double start_sin = std::sin(step * start);
+        for (size_t j = 0; j < count; ++j) {
+            c[start + j] = start_cos * offset_cos[j] - start_sin * offset_sin[j];
+        }
+    }
+
+    switch (w_type) {
+        case WindowType::Hamming: {
+            const double a = 0.54;
+            const double b = 0.46;
+            for (size_t n = 0; n < half; ++n) {
+                c[n] = a - b * c[n];
+            }
+            break;
+        }
+        case WindowType::Hanning: {
+            for (size_t n = 0; n < half; ++n) {
+                c[n] = 0.5 * (1.0 - c[n]);
+            }
+            break;
+        }
+        case WindowType::Blackman:
+        default: {
+            ///<    cos(2x) = 2cos(x)^2 - 1
+            const double a = 0.42;
+            const double b = 0.50;
+            const double d = 0.08;
+            for (size_t n = 0; n < half; ++n) {
+                c[n] = a - b * c[n] + d * (2.0 * c[n] * c[n] - 1.0);
+            }
+            break;
+        }
+    }
+
+    for (size_t n = half; n < N; ++n) {
+        c[n] = c[N - 1 - n];
+    }
+
+    return coefficients;
+}
+
+std::expected <WindowTable, WindowError> getWindowTable(WindowType w_type, size_t size) {
+    WindowCache& cache = getCache();
+    const auto key = std::make_pair(w_type, size);
+
+    {
+        std::lock_guard lock(cache.mutex);
+        if (auto it = cache.entries.find(key); it != cache.entries.end()) {
+            it -> second.last_use = ++cache.uses;
+            return it -> second.table;
+        }
+    }
+
+    ///<    calculated without the lock, so other sizes are not blocked, a concurrent miss on the same key calculates it twice
+    auto coefficients = calculateWindow(w_type, size);
+    if (!coefficients) {
+        return std::unexpected(coefficients.error());
+    }
+
+    WindowTable table = std::make_shared <const std::vector <double>> (std::move(*coefficients));
+
+    ///<    tables larger than a quarter of the capacity would flush everything else, they are returned uncached
+    if (size > WINDOW_CACHE_CAPACITY / 4) {
+        return table;
+    }
+
+    std::lock_guard lock(cache.mutex);
+
+    if (auto it = cache.entries.find(key); it != cache.entries.end()) {
+        it -> second.last_use = ++cache.uses;
+        return it -> second.table;
+    }
+
+    while (cache.samples + size > WINDOW_CACHE_CAPACITY) {
+        auto oldest = cache.entries.begin();
+        for (auto it = cache.entries.begin(); it != cache.entries.end(); ++it) {
+            if (it -> second.last_use < oldest -> second.last_use) {
+                oldest = it;
+            }
+        }
+        cache.samples -= oldest -> first.second;
+        cache.entries.erase(oldest);
+    }
+
+    cache.entries.emplace(key, CacheEntry{table, ++cache.uses});
+    cache.samples += size;
+
+    return table;
+}
+
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Window.hpp"
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <expected>
+
+///<    internal header, not part of the public interface
+
+namespace oh::wnd::detail {
+
+/// @brief immutable window coefficients, shared by every Window and filter design of the same type and size
+using WindowTable = std::shared_ptr <const std::vector <double>>;
+
+/// @brief largest number of coefficients kept by the cache (all tables together), 8 MiB of doubles
+constexpr size_t WINDOW_CACHE_CAPACITY = size_t(1) << 20;
+
+/// @brief calculates the coefficients of a window
+/// @param w_type type of window
+/// @param size size of window, at least 2
+/// @return coefficients on success, WindowError on failure
+std::expected <std::vector <double>, WindowError> calculateWindow(WindowType w_type, size_t size);
+
+/// @brief returns the window of given type and size, calculated once and kept in a thread-safe cache
+/// the least recently used tables are dropped when the cache grows over WINDOW_CACHE_CAPACITY coefficients,
+/// tables still held by a Window stay valid
+/// @param w_type type of window
+/// @param size size of window, at least 2
+/// @return shared table on success, WindowError on failure
+std::expected <WindowTable, WindowError> getWindowTable(WindowType w_type, size_t size);
+
+}
@@ -0,0 +1,136 @@
+#include "EasyDSP.hpp"
+
+#include <vector>
+#include <iostream>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+#include <random>
+
+///<    fixed-point filters with a gain above 2 on full scale inputs: the outputs must saturate with the right sign
+///<    instead of wrapping around, and the others must be the rounded exact sums, on every instruction set
+
+namespace {
+
+using namespace oh::fir;
+
+///<    31 taps of 0.12, sum |h| = 3.72
+constexpr size_t BOOST_TAPS = 31;
+constexpr double BOOST_TAP = 0.12;
+
+/// @brief rounded and saturated sum of the quantised products, in long double, which is exact enough for one unit of the output
+template <class Sample>
+std::vector <Sample> reference(const std::vector <Sample>& h, const std::vector <Sample>& x) {
+    const long double scale = std::ldexp(1.0L, std::numeric_limits <Sample>::digits);
+    std::vector <Sample> y(x.size() + h.size() - 1);
+    for (size_t n = 0; n < y.size(); ++n) {
+        long double sum = 0.0L;
+        for (size_t j = 0; j < h.size(); ++j) {
+            if (n >= j && n - j < x.size()) {
+                sum += static_cast <long double> (h[j]) * x[n - j];
+            }
+        }
+        const long double value = std::round(sum / scale);
+        y[n] = static_cast <Sample> (std::clamp <long double> (value, std::numeric_limits <Sample>::min(), std::numeric_limits <Sample>::max()));
+    }
+    return y;
+}
+
+/// @brief runs one filter on one signal and compares it with the reference, outputs may differ by one unit where the sum is halfway
+template <class Sample>
+bool check(const char* name, const FIR& fir, const std::vector <double>& signal) {
+    auto fixed = BasicFixedPointFIR <Sample>::create(fir);
+    if (!fixed) {
+        std::cout << name << ": " << toString(fixed.error()) << std::endl;
+        return false;
+    }
+
+    std::vector <Sample> x(signal.size());
+    std::transform(signal.begin(), signal.end(), x.begin(), [](double v) { return BasicFixedPointFIR <Sample>::quantise(v); });
+    auto y = fixed -> convolve(x);
+    const std::vector <Sample> expected = reference(fixed -> getCoefficients(), x);
+    if (!y || y -> size() != expected.size()) {
+        std::cout << name << ": convolve failed" << std::endl;
+        return false;
+    }
+
+    for (size_t n = 0; n < expected.size(); ++n) {
+        if (std::abs(static_cast <int64_t> ((*y)[n]) - expected[n]) > 1) {
+            std::cout << name << ", " << toString(getSIMDLevel()) << ": output " << n << " is " << (*y)[n] << " instead of " << expected[n] << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+template <class Sample>
+bool checkAll(const char* name, const FIR& fir, const std::vector <std::vector <double>>& signals) {
+    bool ok = true;
+    for (const auto& signal : signals) {
+        ok = check <Sample> (name, fir, signal) && ok;
+    }
+    return ok;
+}
+
+}
+
+int main() {
+    auto boost = StoredFIR::create(FIRType::Fixed, oh::wnd::WindowType::Rectangular, std::vector <double> (BOOST_TAPS, BOOST_TAP), {});
+
+    ///<    random taps with sum |h| of about 8, the largest a Q15 or Q31 coefficient can hold is just below 1
+    std::mt19937 random(7);
+    std::uniform_real_distribution <double> value(-1.0, 1.0);
+    std::vector <double> h(33);
+    for (auto& v : h) {
+        v = value(random) * 0.5;
+    }
+    auto wild = StoredFIR::create(FIRType::Fixed, oh::wnd::WindowType::Rectangular, h, {});
+    if (!boost || !wild) {
+        std::cout << "cannot create the filters" << std::endl;
+        return 1;
+    }
+
+    ///<    constant +0.9 and -0.9 (the case that used to come out with the wrong sign), full scale noise and a full scale square wave
+    std::vector <std::vector <double>> signals{std::vector <double> (100, 0.9), std::vector <double> (100, -0.9)};
+    std::vector <double> noise(1000);
+    std::vector <double> square(1000);
+    for (size_t n = 0; n < noise.size(); ++n) {
+        noise[n] = value(random);
+        square[n] = (n / 40) % 2 ? -1.0 : 1.0;
+    }
+    signals.push_back(noise);
+    signals.push_back(square);
+
+    const SIMDLevel supported = getSupportedSIMDLevel();
+    bool ok = true;
+    for (SIMDLevel level : {SIMDLevel::Scalar, SIMDLevel::SSE2, SIMDLevel::AVX2, SIMDLevel::AVX512}) {
+        if (level > supported || !setSIMDLevel(level)) {
+            continue;
+        }
+        ok = checkAll <int16_t> ("Q15 boost", *boost, signals) && ok;
+        ok = checkAll <int32_t> ("Q31 boost", *boost, signals) && ok;
+        ok = checkAll <int16_t> ("Q15 random", *wild, signals) && ok;
+        ok = checkAll <int32_t> ("Q31 random", *wild, signals) && ok;
+    }
+    (void)setSIMDLevel(supported);
+
+    ///<    the saturated steady state of the boost filter on +0.9 must be the largest value, not a wrapped negative one
+    auto q31 = Q31FIR::create(*boost);
+    auto y = q31 -> convolve(std::vector <int32_t> (100, Q31FIR::quantise(0.9)));
+    if (!y || (*y)[50] != std::numeric_limits <int32_t>::max()) {
+        std::cout << "Q31 boost: output 50 is " << (y ? (*y)[50] : 0) << " instead of " << std::numeric_limits <int32_t>::max() << std::endl;
+        ok = false;
+    }
+
+    ///<    longer Q31 filters could overflow the split sums and are refused
+    auto too_long = StoredFIR::create(FIRType::Fixed, oh::wnd::WindowType::Rectangular, std::vector <double> (Q31FIR::MAX_SIZE + 1, 1e-6), {});
+    if (!too_long || Q31FIR::create(*too_long) || !Q15FIR::create(*too_long)) {
+        std::cout << "Q31 filters above MAX_SIZE taps must be refused, Q15 ones accepted" << std::endl;
+        ok = false;
+    }
+
+    std::cout << (ok ? "all outputs rounded and saturated" : "failed") << std::endl;
+    return ok ? 0 : 1;
+}
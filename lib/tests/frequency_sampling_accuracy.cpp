@@ -0,0 +1,86 @@
+#include "EasyDSP.hpp"
+
+#include <vector>
+#include <iostream>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <numbers>
+
+///<    FrequencySampling designs its taps with a bluestein inverse fft, this compares them with the cosine sum it replaced:
+///<    h[n] = (A[0] + 2 * sum A[k] * cos(2*pi*k*(n-K)/N)) / N for 0 < k < K, N = 2*K+1
+
+namespace {
+
+constexpr double MAX_RELATIVE_ERROR = 1e-13;
+
+std::vector <double> cosineSum(const std::vector <double>& spectrum) {
+    const size_t K = spectrum.size();
+    const size_t N = 2 * K + 1;
+    std::vector <double> h(N);
+
+    for (size_t n = 0; n < N; ++n) {
+        const double x = static_cast <double> (n) - static_cast <double> (K);
+        double sum = spectrum[0];
+        for (size_t k = 1; k < K; ++k) {
+            sum += 2.0 * spectrum[k] * std::cos(2.0 * std::numbers::pi * k * x / N);
+        }
+        h[n] = sum / N;
+    }
+
+    return h;
+}
+
+}
+
+int main() {
+    ///<    every K up to 64 (all the small bluestein sizes), then sizes around powers of two up to 4000
+    std::vector <size_t> sizes;
+    for (size_t K = 1; K <= 64; ++K) {
+        sizes.push_back(K);
+    }
+    for (size_t K : {100, 127, 128, 129, 255, 256, 257, 511, 512, 1000, 1023, 1024, 1025, 2047, 2048, 3001, 4000}) {
+        sizes.push_back(K);
+    }
+
+    double worst = 0.0;
+    size_t worst_size = 0;
+
+    for (size_t K : sizes) {
+        ///<    a lowpass with a transition band and an irregular passband, so every bin counts
+        std::vector <double> spectrum(K, 0.0);
+        for (size_t k = 0; k < K; ++k) {
+            const double f = static_cast <double> (k) / K;
+            spectrum[k] = f < 0.3 ? 1.0 + 0.25 * std::sin(7.0 * k) : (f < 0.4 ? (0.4 - f) * 10.0 : 0.0);
+        }
+
+        auto fs = oh::fir::FrequencySampling::create(spectrum);
+        if (!fs) {
+            std::cout << "K = " << K << ": " << toString(fs.error()) << std::endl;
+            return 1;
+        }
+
+        const std::vector <double> reference = cosineSum(spectrum);
+        const std::vector <double>& h = fs -> getCoefficients();
+
+        double largest = 0.0;
+        double error = 0.0;
+        for (size_t n = 0; n < reference.size(); ++n) {
+            largest = std::max(largest, std::abs(reference[n]));
+            error = std::max(error, std::abs(h[n] - reference[n]));
+        }
+
+        const double relative = error / largest;
+        if (relative > worst) {
+            worst = relative;
+            worst_size = K;
+        }
+        if (!(relative <= MAX_RELATIVE_ERROR)) {
+            std::cout << "K = " << K << ": relative error " << relative << " above " << MAX_RELATIVE_ERROR << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << sizes.size() << " sizes, largest relative error " << worst << " (K = " << worst_size << ")" << std::endl;
+    return 0;
+}
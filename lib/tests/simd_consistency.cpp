@@ -0,0 +1,214 @@
+#include "EasyDSP.hpp"
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <random>
+
+///<    every instruction set the cpu supports must give the results of the scalar kernels: the fixed-point kernels
+///<    exactly, the floating-point ones up to the rounding of the sums, which the simd kernels add in another order
+
+namespace {
+
+using namespace oh::fir;
+
+///<    relative to sum |h| * max |x|, the largest value a sum can reach
+constexpr double MAX_DOUBLE_ERROR = 1e-15;
+constexpr double MAX_FLOAT_ERROR = 1e-6;
+
+///<    odd and even sizes around the simd widths and unroll factors, so every kernel tail is run
+constexpr size_t TAP_COUNTS[] = {1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 101, 256, 257};
+
+constexpr size_t SIGNAL_SIZES[] = {1, 6, 1000};
+
+constexpr size_t CHANNEL_COUNTS[] = {1, 3, 8};
+
+/// @brief outputs of one filter on one signal, all converted to double
+struct Result {
+    std::string name;
+    std::vector <double> values;
+    double scale;               ///<    sum |h| * max |x|
+    double max_error;           ///<    largest difference to the scalar result relative to scale, 0 means identical
+};
+
+/// @brief asymmetric random taps, or random taps mirrored to symmetric ones, with sum |h| up to 4,
+/// so the fixed-point outputs saturate now and then
+std::vector <double> makeTaps(size_t M, bool symmetric, std::mt19937& random) {
+    std::uniform_real_distribution <double> value(-1.0, 1.0);
+    std::vector <double> h(M);
+    for (auto& v : h) {
+        v = value(random) * 4.0 / M;
+    }
+    if (symmetric) {
+        for (size_t n = 0; n < M / 2; ++n) {
+            h[M - 1 - n] = h[n];
+        }
+    }
+    return h;
+}
+
+template <class Sample>
+std::vector <double> toDouble(const std::vector <Sample>& x) {
+    return std::vector <double> (x.begin(), x.end());
+}
+
+/// @brief direct convolution through FIR, the fft path does not depend on the instruction set
+template <class Sample, class Accumulator>
+std::vector <double> convolveDirect(const FIR& fir, const std::vector <double>& signal) {
+    const std::vector <Sample> x(signal.begin(), signal.end());
+    std::vector <Sample> y(x.size() + fir.getSize() - 1);
+    if (!fir.convolve <Sample, Accumulator> (std::span <const Sample> (x), std::span <Sample> (y), ConvolutionMethod::Direct)) {
+        return {};
+    }
+    return toDouble(y);
+}
+
+template <class Sample, class Accumulator>
+std::vector <double> convolveChannels(const FIR& fir, const std::vector <double>& signal, size_t channels) {
+    auto multichannel = BasicMultichannelFIR <Sample, Accumulator>::create(fir, channels);
+    const size_t frames = signal.size() / channels;
+    if (!multichannel || frames == 0) {
+        return {};
+    }
+    const std::vector <Sample> x(signal.begin(), signal.begin() + frames * channels);
+    std::vector <Sample> y((frames + fir.getSize() - 1) * channels);
+    if (!multichannel -> convolve(x, y, ChannelLayout::Interleaved)) {
+        return {};
+    }
+    return toDouble(y);
+}
+
+template <class Sample>
+std::vector <double> convolveFixed(const FIR& fir, const std::vector <double>& signal) {
+    auto fixed = BasicFixedPointFIR <Sample>::create(fir);
+    if (!fixed) {
+        return {};
+    }
+    std::vector <Sample> x(signal.size());
+    std::transform(signal.begin(), signal.end(), x.begin(), [](double v) { return BasicFixedPointFIR <Sample>::quantise(v); });
+    auto y = fixed -> convolve(x);
+    return y ? toDouble(*y) : std::vector <double> ();
+}
+
+/// @brief runs every kernel on every filter and signal with the instruction set currently set
+std::vector <Result> runAll(const std::vector <StoredFIR>& filters, const std::vector <std::vector <double>>& signals) {
+    std::vector <Result> results;
+    for (const auto& fir : filters) {
+        double gain = 0.0;
+        for (auto v : fir.getCoefficients()) {
+            gain += std::abs(v);
+        }
+        const std::string filter = std::to_string(fir.getSize()) + (fir.isSymmetric() ? " symmetric" : "") + " taps, ";
+
+        for (const auto& signal : signals) {
+            const std::string name = filter + std::to_string(signal.size()) + " samples: ";
+            results.push_back({name + "double", convolveDirect <double, double> (fir, signal), gain, MAX_DOUBLE_ERROR});
+            results.push_back({name + "float", convolveDirect <float, float> (fir, signal), gain, MAX_FLOAT_ERROR});
+            results.push_back({name + "mixed", convolveDirect <float, double> (fir, signal), gain, MAX_FLOAT_ERROR});
+            results.push_back({name + "Q15", convolveFixed <int16_t> (fir, signal), gain, 0.0});
+            results.push_back({name + "Q31", convolveFixed <int32_t> (fir, signal), gain, 0.0});
+
+            for (size_t channels : CHANNEL_COUNTS) {
+                if (signal.size() < channels) {
+                    continue;
+                }
+                const std::string layout = name + std::to_string(channels) + " channels ";
+                results.push_back({layout + "double", convolveChannels <double, double> (fir, signal, channels), gain, MAX_DOUBLE_ERROR});
+                results.push_back({layout + "float", convolveChannels <float, float> (fir, signal, channels), gain, MAX_FLOAT_ERROR});
+                results.push_back({layout + "mixed", convolveChannels <float, double> (fir, signal, channels), gain, MAX_FLOAT_ERROR});
+            }
+        }
+    }
+    return results;
+}
+
+}
+
+int main() {
+    std::mt19937 random(20250101);
+
+    std::vector <StoredFIR> filters;
+    for (size_t M : TAP_COUNTS) {
+        for (bool symmetric : {false, true}) {
+            auto fir = StoredFIR::create(FIRType::Fixed, oh::wnd::WindowType::Rectangular, makeTaps(M, symmetric, random), {});
+            if (!fir) {
+                std::cout << M << " taps: " << toString(fir.error()) << std::endl;
+                return 1;
+            }
+            filters.push_back(std::move(*fir));
+        }
+    }
+
+    std::vector <std::vector <double>> signals;
+    std::uniform_real_distribution <double> sample(-1.0, 1.0);
+    for (size_t N : SIGNAL_SIZES) {
+        std::vector <double> x(N);
+        for (auto& v : x) {
+            v = sample(random);
+        }
+        signals.push_back(std::move(x));
+    }
+
+    const SIMDLevel supported = getSupportedSIMDLevel();
+    if (!setSIMDLevel(SIMDLevel::Scalar)) {
+        std::cout << "cannot select the scalar kernels" << std::endl;
+        return 1;
+    }
+    const std::vector <Result> reference = runAll(filters, signals);
+    for (const auto& r : reference) {
+        if (r.values.empty()) {
+            std::cout << "Scalar, " << r.name << " failed" << std::endl;
+            return 1;
+        }
+    }
+
+    int failed = 0;
+    for (SIMDLevel level : {SIMDLevel::SSE2, SIMDLevel::AVX2, SIMDLevel::AVX512}) {
+        if (level > supported) {
+            std::cout << toString(level) << ": not supported by this cpu, skipped" << std::endl;
+            continue;
+        }
+        if (!setSIMDLevel(level)) {
+            std::cout << toString(level) << ": cannot be selected" << std::endl;
+            failed = 1;
+            continue;
+        }
+
+        const std::vector <Result> results = runAll(filters, signals);
+        double worst_double = 0.0;
+        double worst_float = 0.0;
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Result& expected = reference[i];
+            const Result& r = results[i];
+            if (r.values.size() != expected.values.size()) {
+                std::cout << toString(level) << ", " << r.name << ": " << r.values.size() << " outputs instead of " << expected.values.size() << std::endl;
+                failed = 1;
+                continue;
+            }
+
+            double error = 0.0;
+            for (size_t n = 0; n < r.values.size(); ++n) {
+                error = std::max(error, std::abs(r.values[n] - expected.values[n]));
+            }
+            const double relative = error / r.scale;
+            if (!(relative <= r.max_error)) {
+                std::cout << toString(level) << ", " << r.name << ": relative error " << relative << " above " << r.max_error << std::endl;
+                failed = 1;
+            }
+            double& worst = r.max_error == MAX_DOUBLE_ERROR ? worst_double : worst_float;
+            if (r.max_error > 0.0) {
+                worst = std::max(worst, relative);
+            }
+        }
+
+        std::cout << toString(level) << ": " << results.size() << " results, largest relative error double " << worst_double
+                  << ", float " << worst_float << ", fixed-point identical" << (failed ? " (with failures)" : "") << std::endl;
+    }
+
+    (void)setSIMDLevel(supported);
+    return failed;
+}
@@ -0,0 +1,175 @@
+#include "EasyDSP.hpp"
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <random>
+
+///<    StreamingFIR, PartitionedConvolver and convolveParallel must give the direct convolution of the whole signal,
+///<    whatever the block sizes of the calls (1 sample, size-1 samples, more than a partition) and the threads,
+///<    once the latency each of them reports is removed
+
+namespace {
+
+using namespace oh::fir;
+
+///<    relative to sum |h| * max |x|, the largest value a sum can reach
+constexpr double MAX_ERROR = 1e-14;
+
+///<    short filters on the direct kernels, long ones on the fft engines, and sizes around the partitions
+constexpr size_t TAP_COUNTS[] = {3, 8, 31, 64, 65, 257, 1000, 1024, 4097, 8193};
+
+///<    block size and largest block size of the partitioned convolvers, uniform and not
+constexpr size_t PARTITIONS[][2] = {{8, 8}, {64, 64}, {16, 1024}, {128, 4096}};
+
+constexpr size_t THREAD_COUNTS[] = {1, 3, 8};
+
+/// @brief sizes of the calls: 1, size-1, more than the largest partition, and a few that fit no pattern
+std::vector <size_t> makeBlockSizes(size_t M, size_t partition, size_t total) {
+    const size_t pattern[] = {1, M - 1, 3 * partition + 5, 2, M + 1, 17, 1, partition - 1, 255};
+    std::vector <size_t> sizes;
+    for (size_t done = 0, i = 0; done < total; ++i) {
+        const size_t size = std::min(std::max <size_t> (pattern[i % std::size(pattern)], 1), total - done);
+        sizes.push_back(size);
+        done += size;
+    }
+    return sizes;
+}
+
+/// @brief largest difference between output[n] and reference[n - latency] (0 before the latency), relative to scale
+double getError(const std::vector <double>& output, const std::vector <double>& reference, size_t latency, double scale) {
+    double error = 0.0;
+    for (size_t n = 0; n < output.size(); ++n) {
+        const double expected = n < latency ? 0.0 : reference[n - latency];
+        error = std::max(error, std::abs(output[n] - expected));
+    }
+    return error / scale;
+}
+
+/// @brief feeds the signal to process() in blocks of the given sizes
+template <class Processor>
+std::vector <double> processBlocks(Processor& processor, const std::vector <double>& signal, const std::vector <size_t>& sizes) {
+    std::vector <double> output(signal.size());
+    size_t done = 0;
+    for (size_t size : sizes) {
+        if (!processor.process(std::span <const double> (signal.data() + done, size), std::span <double> (output.data() + done, size))) {
+            return {};
+        }
+        done += size;
+    }
+    return output;
+}
+
+class Checker {
+
+    private:
+
+    double m_worst = 0.0;
+
+    bool m_ok = true;
+
+    public:
+
+    void check(const std::string& name, const std::vector <double>& output, size_t size, const std::vector <double>& reference,
+               size_t latency, double scale) {
+        if (output.size() != size) {
+            std::cout << name << ": failed" << std::endl;
+            m_ok = false;
+            return;
+        }
+        const double error = getError(output, reference, latency, scale);
+        m_worst = std::max(m_worst, error);
+        if (!(error <= MAX_ERROR)) {
+            std::cout << name << ": relative error " << error << " above " << MAX_ERROR << std::endl;
+            m_ok = false;
+        }
+    }
+
+    double getWorst() const noexcept {
+        return m_worst;
+    }
+
+    bool isOk() const noexcept {
+        return m_ok;
+    }
+
+};
+
+}
+
+int main() {
+    std::mt19937 random(31337);
+    std::uniform_real_distribution <double> value(-1.0, 1.0);
+    Checker checker;
+
+    for (size_t M : TAP_COUNTS) {
+        std::vector <double> h(M);
+        for (auto& v : h) {
+            v = value(random) / std::sqrt(static_cast <double> (M));
+        }
+        auto fir = StoredFIR::create(FIRType::Fixed, oh::wnd::WindowType::Rectangular, h, {});
+        if (!fir) {
+            std::cout << M << " taps: " << toString(fir.error()) << std::endl;
+            return 1;
+        }
+
+        ///<    long enough for several calls of every size, and for the largest partitions to fill more than once
+        std::vector <double> signal(std::max <size_t> (2 * M + 1000, 10000));
+        for (auto& v : signal) {
+            v = value(random);
+        }
+
+        double scale = 0.0;
+        for (double v : h) {
+            scale += std::abs(v);
+        }
+        auto reference = fir -> convolve(signal, ConvolutionMethod::Direct);
+        if (!reference) {
+            std::cout << M << " taps: direct convolution failed" << std::endl;
+            return 1;
+        }
+        const std::string taps = std::to_string(M) + " taps";
+
+        auto streaming = StreamingFIR::create(*fir);
+        if (!streaming) {
+            std::cout << taps << ", StreamingFIR: " << toString(streaming.error()) << std::endl;
+            return 1;
+        }
+        checker.check(taps + ", StreamingFIR", processBlocks(*streaming, signal, makeBlockSizes(M, 64, signal.size())),
+                      signal.size(), *reference, 0, scale);
+
+        for (const auto& partition : PARTITIONS) {
+            auto convolver = PartitionedConvolver::create(*fir, partition[0], partition[1]);
+            const std::string name = taps + ", PartitionedConvolver " + std::to_string(partition[0]) + "/" + std::to_string(partition[1]);
+            if (!convolver) {
+                std::cout << name << ": " << toString(convolver.error()) << std::endl;
+                return 1;
+            }
+            checker.check(name, processBlocks(*convolver, signal, makeBlockSizes(M, partition[1], signal.size())),
+                          signal.size(), *reference, convolver -> getLatency(), scale);
+        }
+
+        ///<    whole signals of 1 and size-1 samples as well, fewer samples than threads or than one chunk
+        for (size_t N : {size_t(1), M - 1, signal.size()}) {
+            const std::vector <double> part(signal.begin(), signal.begin() + N);
+            auto expected = fir -> convolve(part, ConvolutionMethod::Direct);
+            for (size_t threads : THREAD_COUNTS) {
+                for (ConvolutionMethod method : {ConvolutionMethod::Direct, ConvolutionMethod::FFT, ConvolutionMethod::Automatic}) {
+                    std::vector <double> output(N + M - 1);
+                    auto written = fir -> convolveParallel(std::span <const double> (part), std::span <double> (output), threads, method);
+                    const std::string name = taps + ", convolveParallel " + std::to_string(N) + " samples, " + std::to_string(threads)
+                                           + " threads, " + toString(method);
+                    checker.check(name, written && *written == output.size() ? output : std::vector <double> (), expected -> size(),
+                                  *expected, 0, scale);
+                }
+            }
+        }
+    }
+
+    std::cout << (checker.isOk() ? "all outputs match the direct convolution" : "failed")
+              << ", largest relative error " << checker.getWorst() << std::endl;
+    return checker.isOk() ? 0 : 1;
+}
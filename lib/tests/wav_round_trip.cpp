@@ -0,0 +1,297 @@
+#include "EasyDSP.hpp"
+
+#include <vector>
+#include <array>
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <optional>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <random>
+
+///<    wav files with more than two channels in every integer width and in float: the samples must read back as
+///<    written (up to the rounding of the format), the header must hold the right sizes, padding and sub format,
+///<    and filterWavFile() must give the convolution of every channel
+
+namespace {
+
+using namespace oh::fir;
+
+constexpr SampleFormat FORMATS[] = {SampleFormat::Int16, SampleFormat::Int24, SampleFormat::Int32, SampleFormat::Float32};
+
+constexpr uint16_t CHANNEL_COUNTS[] = {3, 6};
+
+///<    odd, so 3 channels of Int24 end on an odd byte and the data chunk needs its pad byte
+constexpr size_t FRAMES = 1001;
+
+///<    smaller than the filter and not a divisor of FRAMES, so the history crosses many uneven block edges
+constexpr size_t BLOCK_FRAMES = 97;
+
+constexpr size_t TAPS = 129;
+
+constexpr double MAX_FILTER_ERROR = 1e-12;
+
+///<    KSDATAFORMAT_SUBTYPE_PCM (00000001-0000-0010-8000-00aa00389b71) and KSDATAFORMAT_SUBTYPE_IEEE_FLOAT (00000003-...)
+constexpr std::array <uint8_t, 16> PCM_GUID{0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71};
+constexpr std::array <uint8_t, 16> FLOAT_GUID{0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71};
+
+bool isFloat(SampleFormat format) {
+    return format == SampleFormat::Float32 || format == SampleFormat::Float64;
+}
+
+/// @brief largest difference between a value and the value read back, half a unit of the integer formats
+double getResolution(SampleFormat format) {
+    switch (format) {
+        case SampleFormat::Int16:
+            return std::ldexp(0.5, -15);
+        case SampleFormat::Int24:
+            return std::ldexp(0.5, -23);
+        case SampleFormat::Int32:
+            return std::ldexp(0.5, -31);
+        default:
+            return 0.0;
+    }
+}
+
+uint32_t readU32(const std::vector <uint8_t>& bytes, size_t offset) {
+    uint32_t v;
+    std::memcpy(&v, bytes.data() + offset, sizeof(v));
+    return v;
+}
+
+uint16_t readU16(const std::vector <uint8_t>& bytes, size_t offset) {
+    uint16_t v;
+    std::memcpy(&v, bytes.data() + offset, sizeof(v));
+    return v;
+}
+
+/// @brief walks the chunks of a wav file written by WavWriter and checks every size against the frames it holds
+bool checkHeader(const std::string& name, const std::filesystem::path& path, const WavFormat& format, size_t frames) {
+    std::ifstream file(path, std::ios::binary);
+    const std::vector <uint8_t> bytes{std::istreambuf_iterator <char> (file), std::istreambuf_iterator <char> ()};
+    auto fail = [&](const std::string& what) {
+        std::cout << name << ": " << what << std::endl;
+        return false;
+    };
+
+    if (bytes.size() < 12 || std::memcmp(bytes.data(), "RIFF", 4) != 0 || std::memcmp(bytes.data() + 8, "WAVE", 4) != 0) {
+        return fail("no RIFF/WAVE header");
+    }
+    if (readU32(bytes, 4) != bytes.size() - 8) {
+        return fail("RIFF size " + std::to_string(readU32(bytes, 4)) + " instead of " + std::to_string(bytes.size() - 8));
+    }
+
+    const size_t sample_size = getSampleSize(format.sample_format);
+    const size_t data_size = frames * format.channels * sample_size;
+    bool fmt = false;
+    bool fact = false;
+
+    for (size_t offset = 12; offset + 8 <= bytes.size(); ) {
+        const uint32_t size = readU32(bytes, offset + 4);
+        const size_t body = offset + 8;
+        if (body + size + (size & 1) > bytes.size()) {
+            return fail(std::string(reinterpret_cast <const char*> (bytes.data() + offset), 4) + " chunk passes the end of the file");
+        }
+
+        if (std::memcmp(bytes.data() + offset, "fmt ", 4) == 0) {
+            ///<    more than two channels always need WAVE_FORMAT_EXTENSIBLE
+            if (size != 40 || readU16(bytes, body) != 0xFFFE || readU16(bytes, body + 16) != 22) {
+                return fail("fmt chunk is not WAVE_FORMAT_EXTENSIBLE");
+            }
+            if (readU16(bytes, body + 2) != format.channels || readU32(bytes, body + 4) != format.sample_rate ||
+                readU32(bytes, body + 8) != format.sample_rate * format.channels * sample_size ||
+                readU16(bytes, body + 12) != format.channels * sample_size || readU16(bytes, body + 14) != 8 * sample_size ||
+                readU16(bytes, body + 18) != 8 * sample_size) {
+                return fail("wrong layout in the fmt chunk");
+            }
+            const auto& guid = isFloat(format.sample_format) ? FLOAT_GUID : PCM_GUID;
+            if (std::memcmp(bytes.data() + body + 24, guid.data(), guid.size()) != 0) {
+                return fail("wrong sub format guid");
+            }
+            fmt = true;
+        } else if (std::memcmp(bytes.data() + offset, "fact", 4) == 0) {
+            if (size != 4 || readU32(bytes, body) != frames) {
+                return fail("fact chunk does not hold the number of frames");
+            }
+            fact = true;
+        } else if (std::memcmp(bytes.data() + offset, "data", 4) == 0) {
+            if (size != data_size) {
+                return fail("data size " + std::to_string(size) + " instead of " + std::to_string(data_size));
+            }
+            ///<    chunks are padded to an even size, the pad byte is 0 and the file ends there
+            const size_t end = body + size + (size & 1);
+            if (end != bytes.size() || ((size & 1) && bytes[end - 1] != 0)) {
+                return fail("data chunk is not padded to an even size");
+            }
+            if (!fmt) {
+                return fail("data chunk before the fmt chunk");
+            }
+            if (isFloat(format.sample_format) != fact) {
+                return fail(fact ? "fact chunk in a pcm file" : "no fact chunk in a float file");
+            }
+            return true;
+        }
+        offset = body + size + (size & 1);
+    }
+    return fail("no data chunk");
+}
+
+/// @brief reads a whole wav file through WavReader in uneven pieces
+std::vector <double> readAll(const std::filesystem::path& path, WavFormat& format) {
+    auto reader = WavReader::open(path);
+    if (!reader) {
+        return {};
+    }
+    format = reader->getFormat();
+    std::vector <double> samples(reader->getFrames() * format.channels);
+    for (size_t done = 0, piece = 1; done < reader->getFrames(); piece = piece * 3 + 1) {
+        const size_t count = std::min(piece, reader->getFrames() - done);
+        auto r = reader->read(std::span <double> (samples.data() + done * format.channels, count * format.channels));
+        if (!r || *r != count) {
+            return {};
+        }
+        done += count;
+    }
+    return samples;
+}
+
+bool writeAll(const std::filesystem::path& path, const WavFormat& format, const std::vector <double>& samples) {
+    auto writer = WavWriter::create(path, format);
+    return writer && writer->write(std::span <const double> (samples)) && writer->close();
+}
+
+/// @brief channel c of interleaved samples
+std::vector <double> getChannel(const std::vector <double>& samples, size_t channels, size_t c) {
+    std::vector <double> channel(samples.size() / channels);
+    for (size_t n = 0; n < channel.size(); ++n) {
+        channel[n] = samples[n * channels + c];
+    }
+    return channel;
+}
+
+/// @brief filters a file with filterWavFile() and compares every channel with FIR::convolve() of the input read back
+bool checkFilter(const std::string& name, const FIR& fir, const std::filesystem::path& input, const std::vector <double>& samples,
+                 const WavFormat& format, std::optional <SampleFormat> output_format, bool tail, const std::filesystem::path& output) {
+    const std::string test = name + (tail ? ", filtered with tail to " : ", filtered to ") + toString(output_format.value_or(format.sample_format));
+    auto written = filterWavFile(fir, input, output, {output_format, BLOCK_FRAMES, tail});
+    const size_t frames = FRAMES + (tail ? fir.getSize() - 1 : 0);
+    if (!written || *written != frames) {
+        std::cout << test << ": " << (written ? std::to_string(*written) + " frames written" : toString(written.error())) << std::endl;
+        return false;
+    }
+
+    WavFormat expected_format = format;
+    expected_format.sample_format = output_format.value_or(format.sample_format);
+    if (!checkHeader(test, output, expected_format, frames)) {
+        return false;
+    }
+
+    WavFormat read_format;
+    const std::vector <double> filtered = readAll(output, read_format);
+    if (filtered.size() != frames * format.channels || read_format.sample_format != expected_format.sample_format) {
+        std::cout << test << ": cannot read the output back" << std::endl;
+        return false;
+    }
+
+    ///<    the filter is calculated in double, an output in the input format is rounded (and for integers saturated) once more
+    const double resolution = getResolution(expected_format.sample_format);
+    const bool single = expected_format.sample_format == SampleFormat::Float32;
+    for (size_t c = 0; c < format.channels; ++c) {
+        auto y = fir.convolve(getChannel(samples, format.channels, c));
+        if (!y) {
+            std::cout << test << ": convolve failed" << std::endl;
+            return false;
+        }
+        for (size_t n = 0; n < frames; ++n) {
+            const double expected = isFloat(expected_format.sample_format) ? (*y)[n] : std::clamp((*y)[n], -1.0, 1.0 - 2.0 * resolution);
+            const double tolerance = MAX_FILTER_ERROR + resolution + (single ? 0x1p-24 * std::abs(expected) : 0.0);
+            if (!(std::abs(filtered[n * format.channels + c] - expected) <= tolerance)) {
+                std::cout << test << ": channel " << c << ", frame " << n << " is " << filtered[n * format.channels + c]
+                          << " instead of " << expected << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+}
+
+int main() {
+    std::mt19937 random(1234);
+    std::uniform_real_distribution <double> value(-1.0, 1.0);
+
+    std::vector <double> h(TAPS);
+    for (auto& v : h) {
+        v = value(random) / std::sqrt(static_cast <double> (TAPS));
+    }
+    auto fir = StoredFIR::create(FIRType::Fixed, oh::wnd::WindowType::Rectangular, h, {});
+    if (!fir) {
+        std::cout << "cannot create the filter: " << toString(fir.error()) << std::endl;
+        return 1;
+    }
+
+    const auto directory = std::filesystem::temp_directory_path() / ("easydsp_wav_round_trip_" + std::to_string(random()));
+    std::filesystem::create_directories(directory);
+    const auto input = directory / "input.wav";
+    const auto output = directory / "output.wav";
+
+    bool ok = true;
+    for (SampleFormat sample_format : FORMATS) {
+        for (uint16_t channels : CHANNEL_COUNTS) {
+            const WavFormat format{44100, channels, sample_format};
+            const std::string name = toString(sample_format) + ", " + std::to_string(channels) + " channels";
+
+            ///<    full scale noise, including both ends, which the integer formats saturate to their largest values
+            std::vector <double> samples(FRAMES * channels);
+            for (auto& v : samples) {
+                v = value(random);
+            }
+            samples[0] = 1.0;
+            samples[1] = -1.0;
+
+            if (!writeAll(input, format, samples)) {
+                std::cout << name << ": cannot write the file" << std::endl;
+                ok = false;
+                continue;
+            }
+            ok = checkHeader(name, input, format, FRAMES) && ok;
+
+            WavFormat read_format;
+            const std::vector <double> read = readAll(input, read_format);
+            if (read.size() != samples.size() || read_format.channels != channels || read_format.sample_rate != format.sample_rate ||
+                read_format.sample_format != sample_format) {
+                std::cout << name << ": cannot read the file back" << std::endl;
+                ok = false;
+                continue;
+            }
+
+            const double resolution = getResolution(sample_format);
+            for (size_t n = 0; n < samples.size(); ++n) {
+                ///<    integers saturate one unit below +1, float keeps the nearest float
+                const double expected = isFloat(sample_format) ? static_cast <float> (samples[n]) : std::min(samples[n], 1.0 - 2.0 * resolution);
+                if (!(std::abs(read[n] - expected) <= resolution)) {
+                    std::cout << name << ": sample " << n << " reads back as " << read[n] << " instead of " << samples[n] << std::endl;
+                    ok = false;
+                    break;
+                }
+            }
+
+            for (bool tail : {false, true}) {
+                ok = checkFilter(name, *fir, input, read, format, SampleFormat::Float64, tail, output) && ok;
+                ok = checkFilter(name, *fir, input, read, format, std::nullopt, tail, output) && ok;
+            }
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::remove_all(directory, error);
+
+    std::cout << (ok ? "all wav files read back and filtered as expected" : "failed") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,244 @@
+#include "EasyDSP.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <expected>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+
+using namespace oh::fir;
+
+///<    easydsp-filter: designs a window filter (or loads one from a coefficient file) and applies it to a wav or raw
+///<    sample file without loading the file,
+///<    run with --help for the options
+
+namespace {
+
+/// @brief the filter given on the command line, frequencies are normalised (cycles per sample) once the rate is known
+struct Design {
+    FIRType type = FIRType::WindowLowpass;
+    double fc_low = 0.0;
+    double fc_high = 0.0;
+    size_t taps = 101;
+    oh::wnd::WindowType window = oh::wnd::WindowType::Hamming;
+};
+
+/// @brief moves a designed filter to the heap, FIR itself is abstract
+template <class Filter>
+std::expected <std::unique_ptr <FIR>, FIRError> toPointer(std::expected <Filter, FIRError>&& filter) {
+    if (!filter) {
+        return std::unexpected(filter.error());
+    }
+    return std::make_unique <Filter> (std::move(*filter));
+}
+
+std::expected <std::unique_ptr <FIR>, FIRError> design(const Design& d, double rate) {
+    const double low = d.fc_low / rate;
+    const double high = d.fc_high / rate;
+    switch (d.type) {
+        case FIRType::WindowHighpass:
+            return toPointer(WindowHighpass::create(low, d.taps, d.window));
+        case FIRType::WindowBandpass:
+            return toPointer(WindowBandpass::create(low, high, d.taps, d.window));
+        default:
+            return toPointer(WindowLowpass::create(low, d.taps, d.window));
+    }
+}
+
+std::optional <SampleFormat> parseFormat(const std::string& name) {
+    if (name == "s16") {
+        return SampleFormat::Int16;
+    } else if (name == "s24") {
+        return SampleFormat::Int24;
+    } else if (name == "s32") {
+        return SampleFormat::Int32;
+    } else if (name == "f32") {
+        return SampleFormat::Float32;
+    } else if (name == "f64") {
+        return SampleFormat::Float64;
+    }
+    return std::nullopt;
+}
+
+/// @brief files ending in .wav (any case) are read and written as wav, all others as raw samples
+bool isWav(const std::string& path) {
+    if (path.size() < 4) {
+        return false;
+    }
+    std::string extension = path.substr(path.size() - 4);
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return std::tolower(c); });
+    return extension == ".wav";
+}
+
+std::optional <oh::wnd::WindowType> parseWindow(const std::string& name) {
+    using oh::wnd::WindowType;
+    for (WindowType w : {WindowType::Rectangular, WindowType::Hamming, WindowType::Hanning, WindowType::Blackman}) {
+        if (oh::wnd::toString(w) == name) {
+            return w;
+        }
+    }
+    return std::nullopt;
+}
+
+void printHelp() {
+    std::cout << "usage: easydsp-filter [options] INPUT OUTPUT\n"
+              << "INPUT and OUTPUT are wav files if INPUT ends in .wav, raw sample files otherwise\n"
+              << "filter (one of them, frequencies in Hz for wav files, in cycles per sample for raw files unless --rate is given):\n"
+              << "  --lowpass FC           lowpass with cut-off FC (default: a quarter of the rate)\n"
+              << "  --highpass FC          highpass with cut-off FC\n"
+              << "  --bandpass LOW HIGH    bandpass between LOW and HIGH\n"
+              << "  --taps N               odd number of taps (default 101)\n"
+              << "  --window NAME          Rectangular, Hamming, Hanning or Blackman (default Hamming)\n"
+              << "  --coefficients FILE    taps of a coefficient file written by saveCoefficients(), instead of a design\n"
+              << "  --rate HZ              sample rate of a raw file, the frequencies are given in Hz then\n"
+              << "  --output-format F      output samples: s16, s24, s32, f32 or f64 (default: the input format)\n"
+              << "raw files:\n"
+              << "  --format F             input samples: s16, s24, s32, f32 or f64 (default f32)\n"
+              << "  --channels N           interleaved channels (default 1)\n"
+              << "  --header BYTES         bytes skipped at the start of the input (default 0)\n"
+              << "processing:\n"
+              << "  --block FRAMES         frames filtered per pass, sets the memory in use (default 65536)\n"
+              << "  --tail                 also write the decay of the filter after the input ends\n";
+}
+
+}
+
+int main(int argc, char** argv) {
+    Design d;
+    std::optional <double> rate;
+    bool filter_given = false;
+    std::optional <std::string> coefficients;
+    RawFileOptions options;
+    std::optional <SampleFormat> output_format;
+    std::string paths[2];
+    size_t path_count = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+
+        if (arg == "--lowpass" && has_value) {
+            d.type = FIRType::WindowLowpass;
+            filter_given = true;
+            d.fc_low = std::atof(argv[++i]);
+        } else if (arg == "--highpass" && has_value) {
+            d.type = FIRType::WindowHighpass;
+            filter_given = true;
+            d.fc_low = std::atof(argv[++i]);
+        } else if (arg == "--bandpass" && i + 2 < argc) {
+            d.type = FIRType::WindowBandpass;
+            filter_given = true;
+            d.fc_low = std::atof(argv[++i]);
+            d.fc_high = std::atof(argv[++i]);
+        } else if (arg == "--coefficients" && has_value) {
+            coefficients = argv[++i];
+        } else if (arg == "--taps" && has_value) {
+            d.taps = static_cast <size_t> (std::atol(argv[++i]));
+        } else if (arg == "--window" && has_value) {
+            const auto w = parseWindow(argv[++i]);
+            if (!w) {
+                std::cerr << "unknown window: " << argv[i] << "\n";
+                return 1;
+            }
+            d.window = *w;
+        } else if (arg == "--rate" && has_value) {
+            rate = std::atof(argv[++i]);
+        } else if (arg == "--format" && has_value) {
+            const auto f = parseFormat(argv[++i]);
+            if (!f) {
+                std::cerr << "unknown sample format: " << argv[i] << "\n";
+                return 1;
+            }
+            options.input_format = *f;
+        } else if (arg == "--output-format" && has_value) {
+            output_format = parseFormat(argv[++i]);
+            if (!output_format) {
+                std::cerr << "unknown sample format: " << argv[i] << "\n";
+                return 1;
+            }
+        } else if (arg == "--channels" && has_value) {
+            options.channels = static_cast <size_t> (std::atol(argv[++i]));
+        } else if (arg == "--header" && has_value) {
+            options.header_bytes = static_cast <size_t> (std::atol(argv[++i]));
+        } else if (arg == "--block" && has_value) {
+            options.block_frames = static_cast <size_t> (std::atol(argv[++i]));
+        } else if (arg == "--tail") {
+            options.tail = true;
+        } else if (arg == "--help" || arg == "-h") {
+            printHelp();
+            return 0;
+        } else if (!arg.starts_with("--") && path_count < 2) {
+            paths[path_count++] = arg;
+        } else {
+            std::cerr << "unknown option: " << arg << "\n";
+            printHelp();
+            return 1;
+        }
+    }
+
+    if (path_count != 2) {
+        printHelp();
+        return 1;
+    }
+
+    if (coefficients && filter_given) {
+        std::cerr << "--coefficients cannot be combined with --lowpass, --highpass or --bandpass\n";
+        return 1;
+    }
+
+    std::optional <WavFormat> wav_format;
+    if (isWav(paths[0])) {
+        auto reader = WavReader::open(paths[0]);
+        if (!reader) {
+            std::cerr << "cannot read " << paths[0] << ": " << toString(reader.error()) << "\n";
+            return 1;
+        }
+        wav_format = reader->getFormat();
+        rate = rate.value_or(wav_format->sample_rate);
+    }
+    if (!filter_given) {
+        d.fc_low = 0.25 * rate.value_or(1.0);
+    }
+
+    std::expected <std::unique_ptr <FIR>, FIRError> fir = std::unexpected(FIRError::InvalidParameterValue);
+    if (coefficients) {
+        fir = toPointer(loadCoefficients(*coefficients));
+        if (!fir) {
+            std::cerr << "cannot load " << *coefficients << ": " << toString(fir.error()) << "\n";
+            return 1;
+        }
+    } else {
+        fir = design(d, rate.value_or(1.0));
+        if (!fir) {
+            std::cerr << "invalid filter: " << toString(fir.error()) << "\n";
+            return 1;
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::expected <size_t, FIRError> frames;
+    if (wav_format) {
+        WavFileOptions wav_options;
+        wav_options.output_format = output_format;
+        wav_options.block_frames = options.block_frames;
+        wav_options.tail = options.tail;
+        frames = filterWavFile(**fir, paths[0], paths[1], wav_options);
+    } else {
+        options.output_format = output_format.value_or(options.input_format);
+        frames = filterRawFile(**fir, paths[0], paths[1], options);
+    }
+    if (!frames) {
+        std::cerr << "filtering " << paths[0] << " failed: " << toString(frames.error()) << "\n";
+        return 1;
+    }
+    const double seconds = std::chrono::duration <double> (std::chrono::steady_clock::now() - start).count();
+
+    const size_t channels = wav_format ? wav_format->channels : options.channels;
+    std::cout << *frames << " frames of " << channels << " channel(s) written to " << paths[1]
+              << " in " << seconds << " s\n";
+    return 0;
+}